@@ -0,0 +1,161 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "VRTestWorld.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "VRCharacter.h"
+#include "UObject/UObjectArray.h"
+#include "RenderingThread.h"
+
+static TArray<FVector> MakeArc(int32 numPoints, float sideOffset = 0.0f)
+{
+	TArray<FVector> points;
+	for (int32 i = 0; i < numPoints; i++)
+	{
+		float t = i / 10.0f;
+		points.Add(FVector(100.0f * t, sideOffset * t, 100.0f * t - 50.0f * t * t));
+	}
+	return points;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FVRArcSegmentPoolTest, "VRTest.Teleport.ArcSegmentPool", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FVRArcSegmentPoolTest::RunTest(const FString& Parameters)
+{
+	FVRTestWorld testWorld;
+
+	auto character = testWorld.BeginSpawn<AVRCharacter>();
+	character->FinishSpawning(FTransform::Identity);
+	character->TeleportLeftPress();
+
+	character->UpdateArcSpline(true, MakeArc(32));
+	character->UpdateArcSpline(true, MakeArc(8));
+
+	TestEqual(TEXT("Pooled segments"), character->SplineMeshes.Num(), 31);
+	for (int32 i = 0; i < character->SplineMeshes.Num(); i++)
+	{
+		auto splineMesh = character->SplineMeshes[i];
+		TestNotNull(TEXT("Segment mesh"), splineMesh->GetStaticMesh());
+		TestTrue(FString::Printf(TEXT("Segment %d visible only while in use"), i), splineMesh->IsVisible() == (i < 7));
+	}
+
+	// An invalid destination still draws the short straight stub
+	character->UpdateArcSpline(false, TArray<FVector>());
+	TestTrue(TEXT("Invalid arc stub visible"), character->SplineMeshes[0]->IsVisible());
+	TestFalse(TEXT("Segment past the stub visible"), character->SplineMeshes[1]->IsVisible());
+
+	character->ClearArc();
+	for (auto splineMesh : character->SplineMeshes)
+	{
+		TestFalse(TEXT("Segment visible after clear"), splineMesh->IsVisible());
+	}
+
+	return true;
+}
+
+struct FVRFrameAllocations
+{
+	int64 Allocations;
+	int64 Bytes;
+};
+
+/* Ticks whole frames, including the end of frame render state updates and the render thread's work for them */
+static FVRFrameAllocations MeasureFrames(FVRTestWorld& testWorld, int32 frames, TFunctionRef<void(int32)> perFrame)
+{
+	const float deltaTime = 1.0f / 90.0f;
+
+	auto& allocations = FVRTestAllocationCounter::Get();
+	allocations.Install();
+	allocations.Reset();
+
+	for (int32 frame = 0; frame < frames; frame++)
+	{
+		perFrame(frame);
+		testWorld.Tick(deltaTime);
+		FlushRenderingCommands();
+	}
+
+	allocations.Uninstall();
+
+	return { allocations.Allocations, allocations.Bytes };
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FVRSteadyStateAllocationTest, "VRTest.Teleport.SteadyStateAllocations", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FVRSteadyStateAllocationTest::RunTest(const FString& Parameters)
+{
+	const int32 warmUpFrames = 100;
+	const int32 measuredFrames = 2500;
+
+	FVRTestWorld testWorld;
+
+	auto character = testWorld.BeginSpawn<AVRCharacter>();
+	character->FinishSpawning(FTransform::Identity);
+
+	// The test world has no nav mesh, so every real trace is an invalid destination. The preview is driven
+	// by hand instead so a full arc reaches the render state, with the hand's trace still run every frame.
+	character->SetActorTickEnabled(false);
+
+	TArray<AActor*> attachedActors;
+	character->GetAttachedActors(attachedActors);
+	AVRMotionController* leftHand = nullptr;
+	for (auto actor : attachedActors)
+	{
+		auto hand = Cast<AVRMotionController>(actor);
+		if (hand != nullptr && hand->Hand == EControllerHand::Left)
+		{
+			leftHand = hand;
+		}
+	}
+
+	if (leftHand == nullptr)
+	{
+		AddError(TEXT("Character did not spawn a left hand"));
+		return false;
+	}
+
+	// A hand sweeping slightly from side to side, so every segment is moved each frame without the arc changing length
+	TArray<FVector> arcs[] = { MakeArc(16, -5.0f), MakeArc(16, 0.0f), MakeArc(16, 5.0f), MakeArc(16, 0.0f) };
+
+	auto idleFrame = [character](int32 frame)
+	{
+		character->UpdateTeleportPreview();
+	};
+
+	auto aimAndGrabFrame = [character, leftHand, &arcs](int32 frame)
+	{
+		leftHand->TraceTeleportDestination(character->teleportTraceResult);
+		character->UpdateArcSpline(true, arcs[frame % ARRAY_COUNT(arcs)]);
+		character->UpdateArcEndpoint(arcs[frame % ARRAY_COUNT(arcs)].Last(), true);
+
+		if (frame % 45 == 0)
+		{
+			character->GrabLeft();
+		}
+		else if (frame % 45 == 22)
+		{
+			character->ReleaseLeft();
+		}
+	};
+
+	// Baseline is everything the world and engine allocate per frame with the teleporter inactive
+	MeasureFrames(testWorld, warmUpFrames, idleFrame);
+	auto baseline = MeasureFrames(testWorld, measuredFrames, idleFrame);
+
+	character->TeleportLeftPress();
+	MeasureFrames(testWorld, warmUpFrames, aimAndGrabFrame);
+
+	int32 objectCount = GUObjectArray.GetObjectArrayNumMinusAvailable();
+	auto active = MeasureFrames(testWorld, measuredFrames, aimAndGrabFrame);
+
+	TestEqual(TEXT("UObjects created after warm up"), GUObjectArray.GetObjectArrayNumMinusAvailable() - objectCount, 0);
+
+	int64 extraAllocations = FMath::Max<int64>(active.Allocations - baseline.Allocations, 0);
+	int64 extraBytes = FMath::Max<int64>(active.Bytes - baseline.Bytes, 0);
+	AddInfo(FString::Printf(TEXT("%d frames: %lld allocations (%lld bytes) idle, %lld (%lld bytes) aiming and grabbing"),
+		measuredFrames, baseline.Allocations, baseline.Bytes, active.Allocations, active.Bytes));
+	TestTrue(FString::Printf(TEXT("No allocations beyond the idle baseline, got %lld (%lld bytes)"), extraAllocations, extraBytes), extraAllocations == 0 && extraBytes == 0);
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,99 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "VRTestWorld.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "VRMotionController.h"
+#include "GameFramework/Pawn.h"
+
+static AVRMotionController* SpawnHand(FVRTestWorld& testWorld, AActor* owner)
+{
+	auto hand = testWorld.BeginSpawn<AVRMotionController>(owner);
+	hand->Hand = EControllerHand::Right;
+	hand->FinishSpawning(FTransform::Identity);
+	return hand;
+}
+
+static int32 CountHandsDoingBoneWork(const TArray<AVRMotionController*>& hands)
+{
+	int32 count = 0;
+	for (auto hand : hands)
+	{
+		if (!hand->HandMesh->bNoSkeletonUpdate)
+		{
+			count++;
+		}
+	}
+	return count;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FVRHandIdleScalingTest, "VRTest.HandLOD.IdleRemoteHandsDoNoBoneWork", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FVRHandIdleScalingTest::RunTest(const FString& Parameters)
+{
+	// The per hand cost of idle remote hands should be zero, so bone work stays flat as the number of players grows
+	for (int32 numHands : { 1, 4, 16 })
+	{
+		FVRTestWorld testWorld;
+
+		// A pawn with no controller is never locally controlled
+		auto remotePawn = testWorld.World->SpawnActor<APawn>();
+
+		TArray<AVRMotionController*> hands;
+		for (int32 i = 0; i < numHands; i++)
+		{
+			hands.Add(SpawnHand(testWorld, remotePawn));
+		}
+
+		testWorld.Tick(1.0f / 90.0f);
+		TestEqual(FString::Printf(TEXT("%d remote hands animate before going idle"), numHands), CountHandsDoingBoneWork(hands), numHands);
+
+		testWorld.Tick(1.0f / 90.0f, FMath::CeilToInt(hands[0]->RemoteHandIdleTime * 90.0f) + 1);
+		TestEqual(FString::Printf(TEXT("%d idle remote hands doing bone work"), numHands), CountHandsDoingBoneWork(hands), 0);
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FVRHandIdleFrameRateTest, "VRTest.HandLOD.SlowRemoteHandStaysAwakeAtAnyFrameRate", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FVRHandIdleFrameRateTest::RunTest(const FString& Parameters)
+{
+	// 20cm/s is well under the idle distance per frame at VR frame rates but is clearly a moving hand
+	const float speed = 20.0f;
+
+	for (float frameRate : { 45.0f, 90.0f, 144.0f })
+	{
+		FVRTestWorld testWorld;
+		auto remotePawn = testWorld.World->SpawnActor<APawn>();
+		auto hand = SpawnHand(testWorld, remotePawn);
+
+		const float deltaTime = 1.0f / frameRate;
+		int32 frames = FMath::CeilToInt(hand->RemoteHandIdleTime * 3.0f * frameRate);
+		for (int32 i = 0; i < frames; i++)
+		{
+			hand->SetActorLocation(FVector(speed * deltaTime * i, 0.0f, 0.0f));
+			testWorld.Tick(deltaTime);
+		}
+
+		TestFalse(FString::Printf(TEXT("Slowly moving remote hand frozen at %.0fHz"), frameRate), hand->isHandPoseFrozen);
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FVRHandIdleLocalTest, "VRTest.HandLOD.LocalHandNeverFreezes", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FVRHandIdleLocalTest::RunTest(const FString& Parameters)
+{
+	FVRTestWorld testWorld;
+
+	// Hands without a pawn owner are treated as the local player's
+	auto hand = SpawnHand(testWorld, nullptr);
+
+	testWorld.Tick(1.0f / 90.0f, FMath::CeilToInt(hand->RemoteHandIdleTime * 90.0f) * 2);
+	TestFalse(TEXT("Local hand frozen"), hand->isHandPoseFrozen);
+	TestTrue(TEXT("Local hand is local"), hand->isLocalHand);
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,88 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "VRTestWorld.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "VRMotionController.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StaticMeshActor.h"
+
+static void SpawnBlock(FVRTestWorld& testWorld, UStaticMesh* cube, const FVector& location, const FVector& scale)
+{
+	auto block = testWorld.World->SpawnActor<AStaticMeshActor>(location, FRotator::ZeroRotator);
+	block->GetStaticMeshComponent()->SetMobility(EComponentMobility::Movable);
+	block->GetStaticMeshComponent()->SetStaticMesh(cube);
+	block->SetActorScale3D(scale);
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FVRTargetAssistBenchmark, "VRTest.Perf.TargetAssistFan", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+bool FVRTargetAssistBenchmark::RunTest(const FString& Parameters)
+{
+	const int32 warmUpIterations = 20;
+	const int32 iterations = 500;
+	const int32 fanSizes[] = { 8, 16, 32 };
+
+	auto cube = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube"));
+	if (cube == nullptr)
+	{
+		AddError(TEXT("Couldn't load /Engine/BasicShapes/Cube"));
+		return false;
+	}
+
+	FVRTestWorld testWorld;
+
+	// A floor with a few steps on it, so arcs land at different heights and some are cut short.
+	// There is no nav mesh, so every arc pays for a failed nav projection as well.
+	SpawnBlock(testWorld, cube, FVector(0.0f, 0.0f, -50.0f), FVector(100.0f, 100.0f, 1.0f));
+	for (int32 i = 0; i < 8; i++)
+	{
+		FVector location = FVector(150.0f, 0.0f, 0.0f).RotateAngleAxis(45.0f * i, FVector::UpVector);
+		SpawnBlock(testWorld, cube, location, FVector(0.5f, 0.5f, 0.25f * (i % 3 + 1)));
+	}
+
+	// Hands without a pawn owner are local, as the aiming hand always is
+	auto hand = testWorld.BeginSpawn<AVRMotionController>();
+	hand->Hand = EControllerHand::Right;
+	hand->FinishSpawning(FTransform(FRotator(-30.0f, 0.0f, 0.0f), FVector(0.0f, 0.0f, 150.0f)));
+
+	hand->UseTargetAssist = true;
+	hand->TargetAssistBudgetMs = 0.0f;
+
+	testWorld.Tick(1.0f / 90.0f);
+
+	FTeleportTraceResult result;
+	AddInfo(FString::Printf(TEXT("%8s %10s %12s %12s"), TEXT("arcs"), TEXT("mode"), TEXT("ms/fan"), TEXT("ms/arc")));
+
+	for (int32 fanSize : fanSizes)
+	{
+		for (bool parallel : { false, true })
+		{
+			hand->TargetAssistArcCount = fanSize;
+			hand->TargetAssistParallel = parallel;
+
+			for (int32 i = 0; i < warmUpIterations; i++)
+			{
+				hand->TraceTeleportDestination(result);
+			}
+
+			const double startTime = FPlatformTime::Seconds();
+			for (int32 i = 0; i < iterations; i++)
+			{
+				// Sweep the aim a little so each call traces different arcs
+				hand->SetActorRotation(FRotator(-30.0f, (i % 36) * 10.0f, 0.0f));
+				hand->TraceTeleportDestination(result);
+			}
+			const double ms = (FPlatformTime::Seconds() - startTime) * 1000.0 / iterations;
+
+			// The fan is the requested arcs plus the primary one
+			AddInfo(FString::Printf(TEXT("%8d %10s %12.4f %12.4f"), fanSize, parallel ? TEXT("parallel") : TEXT("serial"), ms, ms / (fanSize + 1)));
+		}
+	}
+
+	AddInfo(FString::Printf(TEXT("Default per frame budget is %.2fms"), GetDefault<AVRMotionController>()->TargetAssistBudgetMs));
+
+	return true;
+}
+
+#endif
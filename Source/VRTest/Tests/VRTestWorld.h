@@ -0,0 +1,140 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/WorldSettings.h"
+#include "HAL/MemoryBase.h"
+
+/* Minimal game world for automation tests. Begins play without a game mode so actors tick and nothing else is spawned. */
+struct FVRTestWorld
+{
+	FVRTestWorld()
+	{
+		World = UWorld::CreateWorld(EWorldType::Game, false);
+
+		FWorldContext& context = GEngine->CreateNewWorldContext(EWorldType::Game);
+		context.SetCurrentWorld(World);
+
+		World->InitializeActorsForPlay(FURL());
+		World->BeginPlay();
+		World->GetWorldSettings()->NotifyBeginPlay();
+	}
+
+	~FVRTestWorld()
+	{
+		GEngine->DestroyWorldContext(World);
+		World->DestroyWorld(false);
+	}
+
+	/* Call FinishSpawning on the result once any properties read in BeginPlay are set */
+	template<typename T>
+	T* BeginSpawn(AActor* owner = nullptr)
+	{
+		return World->SpawnActorDeferred<T>(T::StaticClass(), FTransform::Identity, owner);
+	}
+
+	void Tick(float deltaTime, int32 frames = 1)
+	{
+		for (int32 i = 0; i < frames; i++)
+		{
+			World->Tick(LEVELTICK_All, deltaTime);
+		}
+	}
+
+	UWorld* World;
+};
+
+/**
+ * Counts heap allocations made on any thread while it is installed as GMalloc.
+ * Everything is forwarded to the real allocator, so memory can cross the install boundary in either direction.
+ * There is a single instance for the life of the process, as other threads may have loaded GMalloc just before
+ * it was uninstalled and still call into it afterwards.
+ */
+class FVRTestAllocationCounter : public FMalloc
+{
+public:
+	static FVRTestAllocationCounter& Get()
+	{
+		static FVRTestAllocationCounter counter;
+		return counter;
+	}
+
+	void Install()
+	{
+		// The real allocator is captured once and never cleared, so late callers always have somewhere to forward to
+		if (Inner == nullptr)
+		{
+			Inner = GMalloc;
+		}
+
+		check(GMalloc == Inner);
+		GMalloc = this;
+	}
+
+	void Uninstall()
+	{
+		check(GMalloc == this);
+		GMalloc = Inner;
+	}
+
+	virtual void* Malloc(SIZE_T count, uint32 alignment) override
+	{
+		Count(count);
+		return Inner->Malloc(count, alignment);
+	}
+
+	virtual void* Realloc(void* original, SIZE_T count, uint32 alignment) override
+	{
+		Count(count);
+		return Inner->Realloc(original, count, alignment);
+	}
+
+	virtual void Free(void* original) override
+	{
+		Inner->Free(original);
+	}
+
+	virtual SIZE_T QuantizeSize(SIZE_T count, uint32 alignment) override { return Inner->QuantizeSize(count, alignment); }
+	virtual bool GetAllocationSize(void* original, SIZE_T& sizeOut) override { return Inner->GetAllocationSize(original, sizeOut); }
+	virtual void Trim() override { Inner->Trim(); }
+	virtual void SetupTLSCachesOnCurrentThread() override { Inner->SetupTLSCachesOnCurrentThread(); }
+	virtual void ClearAndDisableTLSCachesOnCurrentThread() override { Inner->ClearAndDisableTLSCachesOnCurrentThread(); }
+	virtual bool IsInternallyThreadSafe() const override { return Inner->IsInternallyThreadSafe(); }
+	virtual bool ValidateHeap() override { return Inner->ValidateHeap(); }
+	virtual const TCHAR* GetDescriptiveName() override { return TEXT("VRTestAllocationCounter"); }
+
+	void Reset()
+	{
+		FPlatformAtomics::InterlockedExchange(&Allocations, 0);
+		FPlatformAtomics::InterlockedExchange(&Bytes, 0);
+	}
+
+	volatile int64 Allocations;
+	volatile int64 Bytes;
+
+private:
+	FVRTestAllocationCounter()
+		: Allocations(0), Bytes(0), Inner(nullptr)
+	{
+	}
+
+	void Count(SIZE_T count)
+	{
+		if (count > 0)
+		{
+			FPlatformAtomics::InterlockedIncrement(&Allocations);
+			FPlatformAtomics::InterlockedAdd(&Bytes, (int64)count);
+		}
+	}
+
+	FMalloc* Inner;
+};
+
+#endif
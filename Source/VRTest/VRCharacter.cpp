@@ -1,6 +1,10 @@
 // Fill out your copyright notice in the Description page of Project Settings.
 
 #include "VRCharacter.h"
+#include "VRTest.h"
+#include "VRFrameRecorder.h"
+#include "VRTestCore/Locomotion.h"
+#include "VRTestCore/Teleport.h"
 
 /* VR Includes */
 #include "HeadMountedDisplay.h"
@@ -13,9 +17,25 @@
 #include "Kismet/GameplayStatics.h"
 #include "TimerManager.h"
 #include "GameFramework/InputSettings.h"
+#include "UObject/ConstructorHelpers.h"
+
+static void SetModelAndMaterial(UStaticMeshComponent* component, const TCHAR* model, const TCHAR* material)
+{
+	ConstructorHelpers::FObjectFinder<UStaticMesh> modelFinder(model);
+	ConstructorHelpers::FObjectFinder<UMaterialInterface> materialFinder(material);
+
+	component->SetStaticMesh(modelFinder.Object);
+	component->SetMaterial(0, materialFinder.Object);
+}
 
 // Sets default values
 AVRCharacter::AVRCharacter()
+	:
+	AimingController(nullptr),
+	ArcSegmentMesh(nullptr),
+	ArcSegmentMaterial(nullptr),
+	isTeleporting(false),
+	isValidTeleportDest(false)
 {
 	GetCapsuleComponent()->InitCapsuleSize(55.f, 96.0f);
 
@@ -32,13 +52,39 @@ AVRCharacter::AVRCharacter()
 	CameraComp->SetupAttachment(VROriginComp);
 	CameraComp->bUsePawnControlRotation = true;
 
-	//LeftMotionController = NewObject<AVRMotionController>();
-	//LeftMotionController->Hand = EControllerHand::Left;
-	//LeftMotionController->AttachToComponent(VROriginComp, FAttachmentTransformRules::SnapToTargetIncludingScale);
-
-	//RightMotionController = NewObject<AVRMotionController>();
-	//RightMotionController->Hand = EControllerHand::Right;
-	//RightMotionController->AttachToComponent(VROriginComp, FAttachmentTransformRules::SnapToTargetIncludingScale);
+	VRTEST_LLM_SCOPE(TeleportArc);
+
+	/* Arc points are traced in world space, so the spline ignores the character transform */
+	ArcSpline = CreateDefaultSubobject<USplineComponent>(TEXT("ArcSpline"));
+	ArcSpline->SetAbsolute(true, true, true);
+	ArcSpline->SetupAttachment(RootComponent);
+
+	ConstructorHelpers::FObjectFinder<UStaticMesh> arcSegmentMeshFinder(TEXT("/Game/VirtualReality/Meshes/BeamMesh.BeamMesh"));
+	ConstructorHelpers::FObjectFinder<UMaterialInterface> arcSegmentMaterialFinder(TEXT("/Game/VirtualReality/Materials/M_SplineArcMat.M_SplineArcMat"));
+	ArcSegmentMesh = arcSegmentMeshFinder.Object;
+	ArcSegmentMaterial = arcSegmentMaterialFinder.Object;
+
+	ArcEndPoint = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("ArcEndPoint"));
+	SetModelAndMaterial(ArcEndPoint, TEXT("/Engine/BasicShapes/Sphere.Sphere"), TEXT("/Game/VirtualReality/Materials/M_ArcEndpoint.M_ArcEndpoint"));
+	ArcEndPoint->SetWorldScale3D(FVector(0.15f, 0.15f, 0.15f));
+	ArcEndPoint->SetAbsolute(true, false, false);
+	ArcEndPoint->SetVisibility(false);
+	ArcEndPoint->SetupAttachment(RootComponent);
+
+	TeleportCylinder = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("TeleportCylinder"));
+	SetModelAndMaterial(TeleportCylinder, TEXT("/Engine/BasicShapes/Cylinder.Cylinder"), TEXT("/Game/VirtualReality/Materials/MI_TeleportCylinderPreview.MI_TeleportCylinderPreview"));
+	TeleportCylinder->SetWorldScale3D(FVector(0.75f, 0.75f, 1.0f));
+	TeleportCylinder->SetAbsolute(true, false, false);
+	TeleportCylinder->SetupAttachment(RootComponent);
+
+	Ring = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("Ring"));
+	SetModelAndMaterial(Ring, TEXT("/Game/VirtualReality/Meshes/SM_FatCylinder.SM_FatCylinder"), TEXT("/Game/VirtualReality/Materials/M_ArcEndpoint.M_ArcEndpoint"));
+	Ring->SetWorldScale3D(FVector(0.5f, 0.5f, 0.15f));
+	Ring->SetupAttachment(TeleportCylinder);
+
+	Arrow = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("Arrow"));
+	SetModelAndMaterial(Arrow, TEXT("/Game/VirtualReality/Meshes/BeaconDirection.BeaconDirection"), TEXT("/Game/VirtualReality/Materials/M_ArcEndpoint.M_ArcEndpoint"));
+	Arrow->SetupAttachment(TeleportCylinder);
 }
 
 // Called when the game starts or when spawned
@@ -49,6 +95,30 @@ void AVRCharacter::BeginPlay()
 	UHeadMountedDisplayFunctionLibrary::SetTrackingOrigin(EHMDTrackingOrigin::Eye);
 	
 	SetupVROptions();
+
+	TeleportCylinder->SetVisibility(false, true);
+
+	LeftMotionController = SpawnMotionController(EControllerHand::Left);
+	RightMotionController = SpawnMotionController(EControllerHand::Right);
+}
+
+AVRMotionController* AVRCharacter::SpawnMotionController(EControllerHand hand)
+{
+	// Hand has to be set before BeginPlay, which picks the tracking source from it
+	auto motionController = GetWorld()->SpawnActorDeferred<AVRMotionController>(AVRMotionController::StaticClass(), FTransform::Identity, this, this);
+	motionController->Hand = hand;
+	motionController->FinishSpawning(FTransform::Identity);
+	motionController->AttachToComponent(VROriginComp, FAttachmentTransformRules::SnapToTargetIncludingScale);
+
+	return motionController;
+}
+
+// Called every frame
+void AVRCharacter::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	UpdateTeleportPreview();
 }
 
 // Called to bind functionality to input
@@ -101,11 +171,12 @@ void AVRCharacter::MoveForward(float Value)
 {
 	if (Value != 0.0f)
 	{
-		auto vector = LeftMotionController->MotionController->GetForwardVector();
-		vector.Y = 0;
+		VRTEST_LLM_SCOPE(Locomotion);
+
+		auto vector = VRTestCore::MoveDirection(ToCore(LeftMotionController->MotionController->GetForwardVector()));
 
 		// add movement in that direction
-		AddMovementInput(vector.GetSafeNormal(), Value);
+		AddMovementInput(FromCore(vector), Value);
 	}
 }
 
@@ -113,11 +184,12 @@ void AVRCharacter::MoveSide(float Value)
 {
 	if (Value != 0.0f)
 	{
-		auto vector = LeftMotionController->MotionController->GetRightVector();
-		vector.Y = 0;
+		VRTEST_LLM_SCOPE(Locomotion);
+
+		auto vector = VRTestCore::MoveDirection(ToCore(LeftMotionController->MotionController->GetRightVector()));
 
 		// add movement in that direction
-		AddMovementInput(vector.GetSafeNormal(), Value);
+		AddMovementInput(FromCore(vector), Value);
 	}
 }
 
@@ -151,16 +223,26 @@ void AVRCharacter::ExecuteTeleport(AVRMotionController* motionController)
 {
 	if (isTeleporting) { return; }
 
-	if (motionController->isValidTeleportDest)
+	if (isValidTeleportDest)
 	{
 		isTeleporting = true;
 		UGameplayStatics::GetPlayerCameraManager(GetWorld(), 0)->StartCameraFade(0.0f, 1.0f, 0.5f, FLinearColor::Black);
 
+		// The preview is shared, so the other hand may rebind and move it before the fade completes
+		FVector destination = GetTeleportDestination();
+
 		FTimerDelegate TimerCallback;
-		TimerCallback.BindLambda([this, motionController]
+		TimerCallback.BindLambda([this, motionController, destination]
 		{
+			VR_RECORD_SCOPE(EVRFrameEvent::Teleport, (uint32)motionController->Hand);
+			VRTEST_LLM_SCOPE(Locomotion);
+
 			motionController->DeactivateTeleporter();
-			TeleportTo(motionController->GetTeleportDestination(), FRotator());
+			if (AimingController == motionController)
+			{
+				HideTeleportPreview();
+			}
+			TeleportTo(destination, FRotator());
 			UGameplayStatics::GetPlayerCameraManager(GetWorld(), 0)->StartCameraFade(1.0f, 0.0f, 0.5f, FLinearColor::Black);
 			isTeleporting = false;
 		});
@@ -171,6 +253,7 @@ void AVRCharacter::ExecuteTeleport(AVRMotionController* motionController)
 	else
 	{
 		motionController->DeactivateTeleporter();
+		HideTeleportPreview();
 	}
 }
 
@@ -196,8 +279,9 @@ void AVRCharacter::TeleportRightRelease()
 
 void AVRCharacter::TeleportPress(AVRMotionController* thisController, AVRMotionController* otherController)
 {
-	thisController->ActivateTeleporter();
 	otherController->DeactivateTeleporter();
+	thisController->ActivateTeleporter();
+	BindTeleportPreview(thisController);
 }
 
 void AVRCharacter::TeleportRelease(AVRMotionController* thisController, AVRMotionController* otherController)
@@ -207,3 +291,143 @@ void AVRCharacter::TeleportRelease(AVRMotionController* thisController, AVRMotio
 		ExecuteTeleport(thisController);
 	}
 }
+
+void AVRCharacter::BindTeleportPreview(AVRMotionController* motionController)
+{
+	AimingController = motionController;
+	TeleportCylinder->SetVisibility(true, true);
+}
+
+void AVRCharacter::HideTeleportPreview()
+{
+	AimingController = nullptr;
+	isValidTeleportDest = false;
+
+	ClearArc();
+	TeleportCylinder->SetVisibility(false, true);
+	ArcEndPoint->SetVisibility(false);
+}
+
+void AVRCharacter::UpdateTeleportPreview()
+{
+	if (AimingController == nullptr)
+	{
+		return;
+	}
+
+	if (!AimingController->isTeleporterActive)
+	{
+		HideTeleportPreview();
+		return;
+	}
+
+	VRTEST_LLM_SCOPE(TeleportArc);
+
+	{
+		VR_RECORD_SCOPE(EVRFrameEvent::TeleportTrace, AimingController->UseTargetAssist ? (uint32)AimingController->TargetAssistArcCount + 1 : 1);
+		isValidTeleportDest = AimingController->TraceTeleportDestination(teleportTraceResult);
+	}
+
+	TeleportCylinder->SetVisibility(isValidTeleportDest, true);
+	TeleportCylinder->SetWorldLocation(teleportTraceResult.NavMeshLocation);
+
+	UpdateArcSpline(isValidTeleportDest, teleportTraceResult.TracePoints);
+	UpdateArcEndpoint(teleportTraceResult.TraceLocation, isValidTeleportDest);
+}
+
+void AVRCharacter::ClearArc()
+{
+	// Spline meshes are pooled, so clearing only hides them
+	HideArcSegments(0);
+
+	ArcSpline->ClearSplinePoints();
+}
+
+void AVRCharacter::HideArcSegments(int32 firstHidden)
+{
+	for (int i = firstHidden; i < SplineMeshes.Num(); i++)
+	{
+		SplineMeshes[i]->SetVisibility(false);
+	}
+}
+
+void AVRCharacter::UpdateArcSpline(bool foundValidLocation, const TArray<FVector>& splinePoints)
+{
+	if (AimingController == nullptr)
+	{
+		return;
+	}
+
+	const FVector* points = splinePoints.GetData();
+	int32 numPoints = splinePoints.Num();
+
+	FVector invalidArc[2];
+	if (!foundValidLocation)
+	{
+		auto arcDirection = AimingController->ArcDirection;
+		invalidArc[0] = arcDirection->GetComponentLocation();
+		invalidArc[1] = FromCore(VRTestCore::InvalidArcEnd(ToCore(arcDirection->GetComponentLocation()), ToCore(arcDirection->GetForwardVector())));
+
+		points = invalidArc;
+		numPoints = 2;
+	}
+
+	// Points are rebuilt every frame, clearing without an update keeps the spline's allocations
+	ArcSpline->ClearSplinePoints(false);
+
+	for (int i = 0; i < numPoints; i++)
+	{
+		ArcSpline->AddSplinePoint(points[i], ESplineCoordinateSpace::Local, false);
+	}
+
+	ArcSpline->SetSplinePointType(numPoints - 1, ESplinePointType::CurveClamped, false);
+	ArcSpline->UpdateSpline();
+
+	int32 numSegments = FMath::Max(ArcSpline->GetNumberOfSplinePoints() - 1, 0);
+	for (int i = 0; i < numSegments; i++)
+	{
+		// Only grows when an arc needs more segments than any arc before it
+		if (i == SplineMeshes.Num())
+		{
+			VR_RECORD_EVENT(EVRFrameEvent::SplineMeshCreate, i + 1);
+
+			auto splineMesh = NewObject<USplineMeshComponent>(this);
+			splineMesh->SetMobility(EComponentMobility::Movable);
+			splineMesh->SetStaticMesh(ArcSegmentMesh);
+			splineMesh->SetMaterial(0, ArcSegmentMaterial);
+			splineMesh->AttachToComponent(ArcSpline, FAttachmentTransformRules::KeepWorldTransform);
+			splineMesh->RegisterComponent();
+			SplineMeshes.Add(splineMesh);
+		}
+
+		// Segments still in use from last frame are already visible, so this only shows ones that were in the hidden tail
+		auto splineMesh = SplineMeshes[i];
+		splineMesh->SetVisibility(true);
+		splineMesh->SetStartAndEnd(
+			points[i], ArcSpline->GetTangentAtSplinePoint(i, ESplineCoordinateSpace::Local),
+			points[i + 1], ArcSpline->GetTangentAtSplinePoint(i + 1, ESplineCoordinateSpace::Local));
+	}
+
+	HideArcSegments(numSegments);
+}
+
+void AVRCharacter::UpdateArcEndpoint(FVector newLocation, bool validLocationFound)
+{
+	ArcEndPoint->SetVisibility(validLocationFound && AimingController != nullptr);
+	ArcEndPoint->SetWorldLocation(newLocation, false, nullptr, ETeleportType::TeleportPhysics);
+
+	FRotator rot;
+	FVector pos;
+	UHeadMountedDisplayFunctionLibrary::GetOrientationAndPosition(rot, pos);
+
+	Arrow->SetWorldRotation(FRotator(0, rot.Yaw, 0));
+}
+
+FVector AVRCharacter::GetTeleportDestination()
+{
+	FRotator rot;
+	FVector pos;
+	UHeadMountedDisplayFunctionLibrary::GetOrientationAndPosition(rot, pos);
+
+	return FromCore(VRTestCore::TeleportDestination(ToCore(TeleportCylinder->GetComponentLocation()), ToCore(pos)));
+}
\ No newline at end of file
@@ -27,6 +27,26 @@ class AVRCharacter : public ACharacter
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components", meta = (AllowPrivateAccess = "true"))
 	class AVRMotionController* RightMotionController;
 
+	/* Teleport preview, shared by both hands and bound to whichever one is aiming */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components", meta = (AllowPrivateAccess = "true"))
+	class USplineComponent* ArcSpline;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components", meta = (AllowPrivateAccess = "true"))
+	class UStaticMeshComponent* ArcEndPoint;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components", meta = (AllowPrivateAccess = "true"))
+	class UStaticMeshComponent* TeleportCylinder;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components", meta = (AllowPrivateAccess = "true"))
+	class UStaticMeshComponent* Ring;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components", meta = (AllowPrivateAccess = "true"))
+	class UStaticMeshComponent* Arrow;
+
+	/* Hand the teleport preview is currently bound to */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Teleportation", meta = (AllowPrivateAccess = "true"))
+	class AVRMotionController* AimingController;
+
 public:
 	/** Base turn rate, in deg/sec. Other scaling may affect final turn rate. */
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Camera)
@@ -39,11 +59,16 @@ public:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
 
+	// Called every frame
+	virtual void Tick(float DeltaTime) override;
+
 	// Called to bind functionality to input
 	virtual void SetupPlayerInputComponent(class UInputComponent* InputComponent) override;
 
 	void SetupVROptions();
 
+	AVRMotionController* SpawnMotionController(EControllerHand hand);
+
 	/* Resets HMD Origin position and orientation */
 	void ResetHMDOrigin();
 
@@ -73,5 +98,43 @@ public:
 
 	void ExecuteTeleport(AVRMotionController* motionController);
 
+	UFUNCTION(BlueprintCallable, Category = "Teleportation")
+	void BindTeleportPreview(AVRMotionController* motionController);
+
+	UFUNCTION(BlueprintCallable, Category = "Teleportation")
+	void HideTeleportPreview();
+
+	void UpdateTeleportPreview();
+
+	UFUNCTION(BlueprintCallable, Category = "Teleportation")
+	void ClearArc();
+
+	/* Hides pooled arc segments from firstHidden onwards */
+	void HideArcSegments(int32 firstHidden);
+
+	UFUNCTION(BlueprintCallable, Category = "Teleportation")
+	void UpdateArcSpline(bool foundValidLocation, const TArray<FVector>& splinePoints);
+
+	UFUNCTION(BlueprintCallable, Category = "Teleportation")
+	void UpdateArcEndpoint(FVector newLocation, bool validLocationFound);
+
+	UFUNCTION(BlueprintCallable, Category = "Teleportation")
+	FVector GetTeleportDestination();
+
+	/* Pooled arc segments, hidden rather than destroyed when the arc shrinks */
+	UPROPERTY()
+	TArray<USplineMeshComponent*> SplineMeshes;
+
+	/* Mesh and material for each arc segment, loaded once so pooled segments can be created at runtime */
+	UPROPERTY()
+	UStaticMesh* ArcSegmentMesh;
+
+	UPROPERTY()
+	UMaterialInterface* ArcSegmentMaterial;
+
+	/* Reused every frame so the trace point array keeps its allocation */
+	FTeleportTraceResult teleportTraceResult;
+
 	bool isTeleporting;
+	bool isValidTeleportDest;
 };
\ No newline at end of file
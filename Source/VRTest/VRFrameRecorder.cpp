@@ -0,0 +1,290 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "VRFrameRecorder.h"
+#include "Async/Async.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "UObject/UObjectGlobals.h"
+#include "UObject/UObjectArray.h"
+
+static TAutoConsoleVariable<float> CVarFrameRecorderBudget(
+	TEXT("VRTest.FrameRecorder.BudgetMs"),
+	1000.0f / 90.0f,
+	TEXT("Frame time in milliseconds above which the frame recorder dumps its history. 0 disables automatic dumps."));
+
+static TAutoConsoleVariable<float> CVarFrameRecorderHistory(
+	TEXT("VRTest.FrameRecorder.HistorySeconds"),
+	5.0f,
+	TEXT("Seconds of history written by a frame recorder dump."));
+
+static FAutoConsoleCommand DumpFrameRecorderCommand(
+	TEXT("VRTest.DumpFrameRecorder"),
+	TEXT("Writes the VR frame recorder history to Saved/Hitches."),
+	FConsoleCommandDelegate::CreateLambda([]()
+	{
+		FString file = FVRFrameRecorder::Get().Dump(TEXT("Manual"));
+		UE_LOG(LogTemp, Display, TEXT("VR frame recorder dumping to %s"), file.IsEmpty() ? TEXT("nowhere, a dump is already in flight") : *file);
+	}));
+
+//---------------------------------------------------------------------------------------------------------------------
+static const TCHAR* GetEventName(EVRFrameEvent event)
+{
+	switch (event)
+	{
+	case EVRFrameEvent::Frame: return TEXT("Frame");
+	case EVRFrameEvent::MotionControllerTick: return TEXT("MotionControllerTick");
+	case EVRFrameEvent::TeleportTrace: return TEXT("TeleportTrace");
+	case EVRFrameEvent::Teleport: return TEXT("Teleport");
+	case EVRFrameEvent::Grab: return TEXT("Grab");
+	case EVRFrameEvent::Release: return TEXT("Release");
+	case EVRFrameEvent::SplineMeshCreate: return TEXT("SplineMeshCreate");
+	case EVRFrameEvent::GarbageCollect: return TEXT("GarbageCollect");
+	case EVRFrameEvent::AssetLoad: return TEXT("AssetLoad");
+	case EVRFrameEvent::MapLoad: return TEXT("MapLoad");
+	}
+	return TEXT("Unknown");
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+static bool ReadSlot(const FVRFrameRecordSlot& slot, FVRFrameRecord& outRecord)
+{
+	// Seqlock read, give up on the slot if a writer was in it before or during the copy
+	const int32 before = slot.Sequence;
+	if (before & 1)
+	{
+		return false;
+	}
+
+	FPlatformMisc::MemoryBarrier();
+	outRecord = slot.Record;
+	FPlatformMisc::MemoryBarrier();
+
+	return slot.Sequence == before;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+static void WriteDump(const FString& file, const FString& reason, float budgetMs, double dumpTime, const TArray<FVRFrameRecord>& records)
+{
+	FString json;
+	json.Reserve(64 + records.Num() * 80);
+	json += FString::Printf(TEXT("{\"reason\":\"%s\",\"budgetMs\":%.3f,\"events\":["), *reason, budgetMs);
+
+	for (int i = 0; i < records.Num(); i++)
+	{
+		const FVRFrameRecord& record = records[i];
+		json += FString::Printf(TEXT("%s{\"t\":%.3f,\"ms\":%.3f,\"frame\":%u,\"type\":\"%s\",\"data\":%u}"),
+			i == 0 ? TEXT("") : TEXT(","),
+			(record.StartTime - dumpTime) * 1000.0,
+			record.Duration * 1000.0f,
+			record.FrameNumber,
+			GetEventName(record.Event),
+			record.Payload);
+	}
+	json += TEXT("]}");
+
+	if (!FFileHelper::SaveStringToFile(json, *file))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("VR frame recorder failed to write %s"), *file);
+	}
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+FVRFrameRecorder& FVRFrameRecorder::Get()
+{
+	static FVRFrameRecorder instance;
+	return instance;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+FVRFrameRecorder::FVRFrameRecorder()
+	:
+	WriteIndex(0),
+	LastFrameEndTime(0.0),
+	ObjectsCreated(0),
+	LastDumpTime(0.0),
+	GarbageCollectStartTime(0.0),
+	MapLoadStartTime(0.0)
+{
+	// Allocated once up front so recording never allocates
+	Slots.SetNumZeroed(Capacity);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void FVRFrameRecorder::Startup()
+{
+	LastFrameEndTime = FPlatformTime::Seconds();
+	GUObjectArray.AddUObjectCreateListener(this);
+
+	EndFrameHandle = FCoreDelegates::OnEndFrame.AddRaw(this, &FVRFrameRecorder::OnEndFrame);
+	PreGarbageCollectHandle = FCoreUObjectDelegates::GetPreGarbageCollectDelegate().AddRaw(this, &FVRFrameRecorder::OnPreGarbageCollect);
+	PostGarbageCollectHandle = FCoreUObjectDelegates::GetPostGarbageCollect().AddRaw(this, &FVRFrameRecorder::OnPostGarbageCollect);
+#if WITH_EDITOR
+	AssetLoadedHandle = FCoreUObjectDelegates::OnAssetLoaded.AddRaw(this, &FVRFrameRecorder::OnAssetLoaded);
+#endif
+	SyncLoadPackageHandle = FCoreUObjectDelegates::OnSyncLoadPackage.AddRaw(this, &FVRFrameRecorder::OnSyncLoadPackage);
+	PreLoadMapHandle = FCoreUObjectDelegates::PreLoadMap.AddRaw(this, &FVRFrameRecorder::OnPreLoadMap);
+	PostLoadMapHandle = FCoreUObjectDelegates::PostLoadMapWithWorld.AddRaw(this, &FVRFrameRecorder::OnPostLoadMap);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void FVRFrameRecorder::Shutdown()
+{
+	GUObjectArray.RemoveUObjectCreateListener(this);
+
+	FCoreDelegates::OnEndFrame.Remove(EndFrameHandle);
+	FCoreUObjectDelegates::GetPreGarbageCollectDelegate().Remove(PreGarbageCollectHandle);
+	FCoreUObjectDelegates::GetPostGarbageCollect().Remove(PostGarbageCollectHandle);
+#if WITH_EDITOR
+	FCoreUObjectDelegates::OnAssetLoaded.Remove(AssetLoadedHandle);
+#endif
+	FCoreUObjectDelegates::OnSyncLoadPackage.Remove(SyncLoadPackageHandle);
+	FCoreUObjectDelegates::PreLoadMap.Remove(PreLoadMapHandle);
+	FCoreUObjectDelegates::PostLoadMapWithWorld.Remove(PostLoadMapHandle);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void FVRFrameRecorder::Record(EVRFrameEvent event, double startTime, double duration, uint32 payload)
+{
+	// Claim a slot and overwrite whatever was there, writers never wait on each other or on a dump
+	int64 index = FPlatformAtomics::InterlockedIncrement(&WriteIndex) - 1;
+
+	FVRFrameRecordSlot& slot = Slots[index & (Capacity - 1)];
+
+	// Odd while writing, the increments are full barriers so readers see the record complete or not at all
+	FPlatformAtomics::InterlockedIncrement(&slot.Sequence);
+
+	slot.Record.StartTime = startTime;
+	slot.Record.Duration = (float)duration;
+	slot.Record.FrameNumber = (uint32)GFrameCounter;
+	slot.Record.Payload = payload;
+	slot.Record.Event = event;
+
+	FPlatformAtomics::InterlockedIncrement(&slot.Sequence);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+FString FVRFrameRecorder::Dump(const TCHAR* reason)
+{
+	if (IsDumpInFlight)
+	{
+		return FString();
+	}
+
+	const double now = FPlatformTime::Seconds();
+	const double historyStart = now - CVarFrameRecorderHistory.GetValueOnGameThread();
+	const int64 end = WriteIndex;
+	const int64 begin = FMath::Max<int64>(0, end - Capacity);
+
+	LastDumpTime = now;
+	IsDumpInFlight = true;
+
+	// Only the copy happens here, formatting and file IO would add to the hitch being reported
+	TSharedRef<TArray<FVRFrameRecord>, ESPMode::ThreadSafe> snapshot = MakeShareable(new TArray<FVRFrameRecord>());
+	snapshot->Reserve((int32)(end - begin));
+
+	double oldestTime = now;
+	for (int64 i = begin; i < end; i++)
+	{
+		FVRFrameRecord record;
+		if (ReadSlot(Slots[i & (Capacity - 1)], record))
+		{
+			oldestTime = FMath::Min(oldestTime, record.StartTime);
+			if (record.StartTime >= historyStart && record.StartTime <= now)
+			{
+				snapshot->Add(record);
+			}
+		}
+	}
+
+	if (begin > 0 && oldestTime > historyStart)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("VR frame recorder wrapped, dump covers %.2fs of the %.2fs history window"), now - oldestTime, now - historyStart);
+	}
+
+	FString file = FPaths::ProjectSavedDir() / TEXT("Hitches") / FString::Printf(TEXT("Hitch-%s.json"), *FDateTime::Now().ToString());
+	FString reasonString = reason;
+	float budgetMs = CVarFrameRecorderBudget.GetValueOnGameThread();
+
+	AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [this, file, reasonString, budgetMs, now, snapshot]()
+	{
+		WriteDump(file, reasonString, budgetMs, now, *snapshot);
+		IsDumpInFlight = false;
+	});
+
+	return file;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void FVRFrameRecorder::NotifyUObjectCreated(const UObjectBase* object, int32 index)
+{
+	// Counted at creation rather than from the object array size, so objects freed by GC in the same frame don't hide them
+	FPlatformAtomics::InterlockedIncrement(&ObjectsCreated);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void FVRFrameRecorder::OnEndFrame()
+{
+	const double now = FPlatformTime::Seconds();
+	const double frameTime = now - LastFrameEndTime;
+
+	// Steady state interaction shouldn't create any UObjects, so anything here points at per frame churn
+	const int32 objectsCreated = FPlatformAtomics::InterlockedExchange(&ObjectsCreated, 0);
+
+	Record(EVRFrameEvent::Frame, LastFrameEndTime, frameTime, objectsCreated);
+	LastFrameEndTime = now;
+
+	// Only dump once per history window, a dump would otherwise cause the next hitch
+	const float budgetMs = CVarFrameRecorderBudget.GetValueOnGameThread();
+	if (budgetMs > 0.0f && frameTime * 1000.0 > budgetMs && now - LastDumpTime > CVarFrameRecorderHistory.GetValueOnGameThread())
+	{
+		FString file = Dump(TEXT("Hitch"));
+		if (!file.IsEmpty())
+		{
+			UE_LOG(LogTemp, Warning, TEXT("VR frame took %.2fms, frame recorder dumping to %s"), frameTime * 1000.0, *file);
+		}
+
+		// Don't blame the next frame for the dump
+		LastFrameEndTime = FPlatformTime::Seconds();
+	}
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void FVRFrameRecorder::OnPreGarbageCollect()
+{
+	GarbageCollectStartTime = FPlatformTime::Seconds();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void FVRFrameRecorder::OnPostGarbageCollect()
+{
+	Record(EVRFrameEvent::GarbageCollect, GarbageCollectStartTime, FPlatformTime::Seconds() - GarbageCollectStartTime);
+}
+
+#if WITH_EDITOR
+//---------------------------------------------------------------------------------------------------------------------
+void FVRFrameRecorder::OnAssetLoaded(UObject* asset)
+{
+	Record(EVRFrameEvent::AssetLoad, FPlatformTime::Seconds(), 0.0);
+}
+#endif
+
+//---------------------------------------------------------------------------------------------------------------------
+void FVRFrameRecorder::OnSyncLoadPackage(const FString& packageName)
+{
+	// Blocking package loads are the ones that hitch, and unlike OnAssetLoaded this fires in game builds
+	Record(EVRFrameEvent::AssetLoad, FPlatformTime::Seconds(), 0.0);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void FVRFrameRecorder::OnPreLoadMap(const FString& mapName)
+{
+	MapLoadStartTime = FPlatformTime::Seconds();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void FVRFrameRecorder::OnPostLoadMap(UWorld* world)
+{
+	Record(EVRFrameEvent::MapLoad, MapLoadStartTime, FPlatformTime::Seconds() - MapLoadStartTime);
+}
@@ -0,0 +1,126 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/ThreadSafeBool.h"
+#include "UObject/UObjectArray.h"
+
+enum class EVRFrameEvent : uint8
+{
+	/* Payload is the number of UObjects created during the frame, on any thread, regardless of how many were freed */
+	Frame,
+	MotionControllerTick,
+	TeleportTrace,
+	Teleport,
+	Grab,
+	Release,
+	SplineMeshCreate,
+	GarbageCollect,
+	AssetLoad,
+	MapLoad,
+};
+
+struct FVRFrameRecord
+{
+	double StartTime;
+	float Duration;
+	uint32 FrameNumber;
+	uint32 Payload;
+	EVRFrameEvent Event;
+};
+
+/* Ring buffer slot. Sequence is odd while a writer is filling the record, so readers can detect a torn read. */
+struct FVRFrameRecordSlot
+{
+	volatile int32 Sequence;
+	FVRFrameRecord Record;
+};
+
+/**
+ * Always-on flight recorder for VR hitches.
+ * Events are written into a fixed size ring buffer without locking. Capacity covers the history window for
+ * the local player's events at VR frame rates, so per-avatar events shouldn't be recorded. When a frame goes over budget
+ * the last few seconds are dumped to Saved/Hitches as JSON, or on demand with VRTest.DumpFrameRecorder.
+ * Dumps snapshot the buffer on the game thread and format and write the file on a background task.
+ */
+class VRTEST_API FVRFrameRecorder : private FUObjectArray::FUObjectCreateListener
+{
+public:
+	static FVRFrameRecorder& Get();
+
+	void Startup();
+	void Shutdown();
+
+	/* Safe to call from any thread */
+	void Record(EVRFrameEvent event, double startTime, double duration, uint32 payload = 0);
+
+	/* Starts writing the recorded history to disk, returns the file being written or an empty string if a dump is already in flight */
+	FString Dump(const TCHAR* reason);
+
+private:
+	FVRFrameRecorder();
+
+	virtual void NotifyUObjectCreated(const class UObjectBase* object, int32 index) override;
+
+	void OnEndFrame();
+	void OnPreGarbageCollect();
+	void OnPostGarbageCollect();
+#if WITH_EDITOR
+	void OnAssetLoaded(UObject* asset);
+#endif
+	void OnSyncLoadPackage(const FString& packageName);
+	void OnPreLoadMap(const FString& mapName);
+	void OnPostLoadMap(UWorld* world);
+
+	static const int32 Capacity = 16384;
+
+	TArray<FVRFrameRecordSlot> Slots;
+	volatile int64 WriteIndex;
+
+	double LastFrameEndTime;
+	volatile int32 ObjectsCreated;
+	double LastDumpTime;
+	FThreadSafeBool IsDumpInFlight;
+	double GarbageCollectStartTime;
+	double MapLoadStartTime;
+
+	FDelegateHandle EndFrameHandle;
+	FDelegateHandle PreGarbageCollectHandle;
+	FDelegateHandle PostGarbageCollectHandle;
+	FDelegateHandle AssetLoadedHandle;
+	FDelegateHandle SyncLoadPackageHandle;
+	FDelegateHandle PreLoadMapHandle;
+	FDelegateHandle PostLoadMapHandle;
+};
+
+/* Records the lifetime of the enclosing scope */
+struct FVRFrameRecorderScope
+{
+	FVRFrameRecorderScope(EVRFrameEvent event, uint32 payload = 0)
+		: Event(event), Payload(payload), StartTime(FPlatformTime::Seconds()), Enabled(true)
+	{
+	}
+
+	FVRFrameRecorderScope(bool enabled, EVRFrameEvent event, uint32 payload = 0)
+		: Event(event), Payload(payload), StartTime(enabled ? FPlatformTime::Seconds() : 0.0), Enabled(enabled)
+	{
+	}
+
+	~FVRFrameRecorderScope()
+	{
+		if (Enabled)
+		{
+			FVRFrameRecorder::Get().Record(Event, StartTime, FPlatformTime::Seconds() - StartTime, Payload);
+		}
+	}
+
+	EVRFrameEvent Event;
+	uint32 Payload;
+	double StartTime;
+	bool Enabled;
+};
+
+#define VR_RECORD_SCOPE(Event, ...) FVRFrameRecorderScope ANONYMOUS_VARIABLE(VRFrameRecorderScope)(Event, ##__VA_ARGS__)
+#define VR_RECORD_SCOPE_IF(Condition, Event, ...) FVRFrameRecorderScope ANONYMOUS_VARIABLE(VRFrameRecorderScope)(!!(Condition), Event, ##__VA_ARGS__)
+#define VR_RECORD_EVENT(Event, ...) FVRFrameRecorder::Get().Record(Event, FPlatformTime::Seconds(), 0.0, ##__VA_ARGS__)
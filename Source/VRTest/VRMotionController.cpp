@@ -1,6 +1,9 @@
 // Fill out your copyright notice in the Description page of Project Settings.
 
 #include "VRMotionController.h"
+#include "VRTest.h"
+#include "VRFrameRecorder.h"
+#include "Async/ParallelFor.h"
 #include "Kismet/GameplayStatics.h"
 #include "Kismet/KismetSystemLibrary.h"
 #include "Runtime/CoreUObject/Public/UObject/ConstructorHelpers.h"
@@ -12,15 +15,76 @@
 #include "Animation/AnimBlueprintGeneratedClass.h"
 #include "HandAnimation.h"
 #include "VRCharacter.h"
+#include "VRTestCore/Grab.h"
+#include "VRTestCore/Teleport.h"
+
+DECLARE_CYCLE_STAT(TEXT("Trace Teleport Arc"), STAT_TraceTeleportArc, STATGROUP_VRTest);
+DECLARE_CYCLE_STAT(TEXT("Trace Teleport Arc Fan"), STAT_TraceTeleportArcFan, STATGROUP_VRTest);
+DECLARE_CYCLE_STAT(TEXT("Score Teleport Arc Fan"), STAT_ScoreTeleportArcFan, STATGROUP_VRTest);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Teleport Arcs Traced"), STAT_TeleportArcsTraced, STATGROUP_VRTest);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Teleport Arcs In Fan"), STAT_TeleportArcsInFan, STATGROUP_VRTest);
+
+static const int32 MaxTargetAssistArcs = 32;
+
+struct FFingerCollisionShape
+{
+	const TCHAR* Name;
+	const TCHAR* Bone;
+	float Radius;
+	float HalfHeight;
+};
+
+/* One capsule per finger of the mannequin hand, lying along the bone from its base joint.
+   The right hand bones point down -X; the left hand is the same mesh mirrored, so the offset holds for both. */
+static const FFingerCollisionShape FingerCollisionShapes[] =
+{
+	{ TEXT("ThumbCollision"), TEXT("thumb_01_r"), 1.2f, 4.0f },
+	{ TEXT("IndexCollision"), TEXT("index_01_r"), 1.0f, 4.5f },
+	{ TEXT("MiddleCollision"), TEXT("middle_01_r"), 1.0f, 5.0f },
+	{ TEXT("RingCollision"), TEXT("ring_01_r"), 1.0f, 4.5f },
+	{ TEXT("PinkyCollision"), TEXT("pinky_01_r"), 0.9f, 3.5f },
+};
 
 //---------------------------------------------------------------------------------------------------------------------
-void SetModelAndMaterial(UStaticMeshComponent* component, const TCHAR* model, const TCHAR* material)
+static void SetupHandCollision(UPrimitiveComponent* component)
 {
-	ConstructorHelpers::FObjectFinder<UStaticMesh> modelFinder(model);
-	ConstructorHelpers::FObjectFinder<UMaterialInterface> materialFinder(material);
+	// Bodies stay in the physics scene for the life of the hand, gripping only changes what they respond to
+	component->SetCollisionEnabled(ECollisionEnabled::QueryAndPhysics);
+	component->SetCollisionObjectType(ECollisionChannel::ECC_WorldDynamic);
+	component->SetCollisionResponseToAllChannels(ECR_Ignore);
+	component->bGenerateOverlapEvents = false;
+	component->SetHiddenInGame(true);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+static void TraceArc(UWorld* world, const FVector& start, const FVector& velocity, float gravityZ, FTeleportArc& arc)
+{
+	// The core samples the same path PredictProjectilePath would, each step is then traced against static geometry
+	VRTestCore::Vec3 points[VRTestCore::ArcMaxPoints];
+	const int32 numPoints = VRTestCore::SampleBallisticArc(ToCore(start), ToCore(velocity), gravityZ, points, VRTestCore::ArcMaxPoints);
+
+	static const FName TraceTag(TEXT("TeleportArc"));
+	const FCollisionObjectQueryParams objectParams(ECC_WorldStatic);
+	const FCollisionQueryParams queryParams(TraceTag, false);
+
+	arc.Hit = false;
+	arc.NumPoints = 0;
+	arc.Points[arc.NumPoints++] = FromCore(points[0]);
+
+	for (int32 i = 1; i < numPoints; i++)
+	{
+		FHitResult hit;
+		if (world->LineTraceSingleByObjectType(hit, FromCore(points[i - 1]), FromCore(points[i]), objectParams, queryParams))
+		{
+			arc.Points[arc.NumPoints++] = hit.Location;
+			arc.Hit = true;
+			break;
+		}
+
+		arc.Points[arc.NumPoints++] = FromCore(points[i]);
+	}
 
-	component->SetStaticMesh(modelFinder.Object);
-	component->SetMaterial(0, materialFinder.Object);
+	arc.EndLocation = arc.Points[arc.NumPoints - 1];
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -28,13 +92,30 @@ void SetModelAndMaterial(UStaticMeshComponent* component, const TCHAR* model, co
 AVRMotionController::AVRMotionController()
 	:
 	GrabbedActor(nullptr),
+	PickupInterface(nullptr),
+	UseTargetAssist(false),
+	TargetAssistArcCount(16),
+	TargetAssistConeAngle(15.0f),
+	TargetAssistBudgetMs(1.0f),
+	TargetAssistParallel(true),
+	UseSimpleHandCollision(true),
+	RemoteHandIdleTime(1.0f),
+	RemoteHandIdleDistance(2.0f),
+	RemoteHandMinLOD(1),
 	isTeleporterActive(false),
 	wantsToGrip(false),
-	isValidTeleportDest(false)
+	isLocalHand(true),
+	isHandPoseFrozen(false),
+	handIdleTime(0.0f),
+	idleAnchorLocation(FVector::ZeroVector),
+	lastWantsToGrip(false),
+	targetAssistCostPerArcMs(0.0f)
 {
  	// Set this actor to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
 	PrimaryActorTick.bCanEverTick = true;
 
+	VRTEST_LLM_SCOPE(HandVisuals);
+
 	//ConstructorHelpers::FObjectFinder<UHapticFeedbackEffect_Base> hapticFeedbackFinder(TEXT("/Game/HapticFeedback/HapticImpulse.HapticImpulse"));
 	//HapticFeebackEffect = hapticFeedbackFinder.Object;
 
@@ -47,39 +128,37 @@ AVRMotionController::AVRMotionController()
 	HandMesh = CreateDefaultSubobject<USkeletalMeshComponent>(TEXT("HandMesh"));
 	HandMesh->SkeletalMesh = meshFinder.Object;
 	HandMesh->SetMaterial(0, materialFinder.Object);
+	HandMesh->VisibilityBasedAnimTickOption = EMeshComponentUpdateFlag::AlwaysTickPoseAndRefreshBones;
+	HandMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
 	//HandMesh->SetAnimInstanceClass(HandAnimation::GetClass());
 	HandMesh->SetupAttachment(MotionController);
 
 	ArcDirection = CreateDefaultSubobject<UArrowComponent>(TEXT("ArcDirection"));
 	ArcDirection->SetupAttachment(HandMesh);
 
-	ArcSpline = CreateDefaultSubobject<USplineComponent>(TEXT("ArcSpline"));
-	ArcSpline->SetupAttachment(HandMesh);
-
 	GrabSphere = CreateDefaultSubobject<USphereComponent>(TEXT("GrabSphere"));
 	GrabSphere->SetSphereRadius(10.0f);
 	GrabSphere->SetHiddenInGame(true);
 	GrabSphere->SetupAttachment(HandMesh);
 
-	ArcEndPoint = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("ArcEndPoint"));
-	SetModelAndMaterial(ArcEndPoint, TEXT("/Engine/BasicShapes/Sphere.Sphere"), TEXT("/Game/VirtualReality/Materials/M_ArcEndpoint.M_ArcEndpoint"));
-	ArcEndPoint->SetWorldScale3D(FVector(0.15f, 0.15f, 0.15f));
-	ArcEndPoint->SetVisibility(false);
-	ArcEndPoint->SetupAttachment(RootComponent);
-
-	TeleportCylinder = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("TeleportCylinder"));
-	SetModelAndMaterial(TeleportCylinder, TEXT("/Engine/BasicShapes/Cylinder.Cylinder"), TEXT("/Game/VirtualReality/Materials/MI_TeleportCylinderPreview.MI_TeleportCylinderPreview"));
-	TeleportCylinder->SetWorldScale3D(FVector(0.75f, 0.75f, 1.0f));
-	TeleportCylinder->SetupAttachment(RootComponent);
-
-	Ring = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("Ring"));
-	SetModelAndMaterial(Ring, TEXT("/Game/VirtualReality/Meshes/SM_FatCylinder.SM_FatCylinder"), TEXT("/Game/VirtualReality/Materials/M_ArcEndpoint.M_ArcEndpoint"));
-	Ring->SetWorldScale3D(FVector(0.5f, 0.5f, 0.15f));
-	Ring->SetupAttachment(TeleportCylinder);
-
-	Arrow = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("Arrow"));
-	SetModelAndMaterial(Arrow, TEXT("/Game/VirtualReality/Meshes/BeaconDirection.BeaconDirection"), TEXT("/Game/VirtualReality/Materials/M_ArcEndpoint.M_ArcEndpoint"));
-	Arrow->SetupAttachment(TeleportCylinder);
+	ConstructorHelpers::FClassFinder<UInterface> pickupInterfaceFinder(TEXT("/Game/VirtualRealityBP/Blueprints/PickupActorInterface"));
+	PickupInterface = pickupInterfaceFinder.Class;
+
+	PalmCollision = CreateDefaultSubobject<UBoxComponent>(TEXT("PalmCollision"));
+	PalmCollision->SetBoxExtent(FVector(5.0f, 4.0f, 1.5f));
+	SetupHandCollision(PalmCollision);
+	PalmCollision->SetupAttachment(HandMesh, TEXT("hand_r"));
+
+	for (auto& shape : FingerCollisionShapes)
+	{
+		auto finger = CreateDefaultSubobject<UCapsuleComponent>(shape.Name);
+		finger->InitCapsuleSize(shape.Radius, shape.HalfHeight);
+		finger->SetRelativeLocation(FVector(-shape.HalfHeight, 0.0f, 0.0f));
+		finger->SetRelativeRotation(FRotator(90.0f, 0.0f, 0.0f));
+		SetupHandCollision(finger);
+		finger->SetupAttachment(HandMesh, shape.Bone);
+		FingerCollision.Add(finger);
+	}
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -98,7 +177,7 @@ void AVRMotionController::BeginPlay()
 		MotionController->MotionSource = FXRMotionControllerBase::RightHandSourceId;
 	}
 
-	TeleportCylinder->SetVisibility(false, true);
+	ApplyHandLODPolicy(IsHandLocallyControlled());
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -107,32 +186,25 @@ void AVRMotionController::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
 
-	// Update animation of hand
-	//auto animInstance = (UAnimBlueprintGeneratedClass*)HandMesh->GetAnimInstance();
-	//animInstance->set;
+	bool isLocal = IsHandLocallyControlled();
 
-	if (wantsToGrip)
-	{
-		HandMesh->SetCollisionEnabled(ECollisionEnabled::QueryAndPhysics);
-	}
-	else
+	// Only the local hands are recorded, an event per remote hand per frame would wrap the ring inside its history window
+	VR_RECORD_SCOPE_IF(isLocal, EVRFrameEvent::MotionControllerTick, (uint32)Hand);
+	VRTEST_LLM_SCOPE(HandVisuals);
+
+	if (isLocal != isLocalHand)
 	{
-		HandMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+		ApplyHandLODPolicy(isLocal);
 	}
 
-	ClearArc();
-	if (isTeleporterActive)
+	if (!isLocalHand)
 	{
-		FTeleportTraceResult result;
-		bool foundDest = TraceTeleportDestination(result);
-		isValidTeleportDest = foundDest;
-
-		TeleportCylinder->SetVisibility(isValidTeleportDest, true);
-		TeleportCylinder->SetWorldLocation(result.NavMeshLocation);
-
-		UpdateArcSpline(isValidTeleportDest, result.TracePoints);
-		UpdateArcEndpoint(result.TraceLocation, isValidTeleportDest);
+		UpdateHandIdle(DeltaTime);
 	}
+
+	// Update animation of hand
+	//auto animInstance = (UAnimBlueprintGeneratedClass*)HandMesh->GetAnimInstance();
+	//animInstance->set;
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -145,39 +217,41 @@ void AVRMotionController::RumbleController(float _intensity)
 //---------------------------------------------------------------------------------------------------------------------
 AActor* AVRMotionController::GetActorNearHand()
 {
-	ConstructorHelpers::FObjectFinder<UInterface> pickupInterfaceFinder(TEXT("/Game/VirtualRealityBP/Blueprints/PickupActorInterface.PickupActorInterface"));
-	auto pickupInterface = pickupInterfaceFinder.Object->StaticClass();
+	VRTEST_LLM_SCOPE(Grab);
 
-	float nearest = FLT_MAX;
-	AActor* nearestActor = nullptr;
+	if (PickupInterface == nullptr)
+	{
+		return nullptr;
+	}
 
-	auto handPos = GrabSphere->GetComponentLocation();
+	TArray<AActor*, TInlineAllocator<8>> pickups;
+	TArray<VRTestCore::Vec3, TInlineAllocator<8>> pickupPositions;
 
 	TArray<AActor*> overlappingActors;
 	GrabSphere->GetOverlappingActors(overlappingActors);
 	for (int i = 0; i < overlappingActors.Num(); i++)
 	{
 		auto actor = overlappingActors[i];
-		if (UKismetSystemLibrary::DoesImplementInterface(actor, pickupInterface))
+		if (UKismetSystemLibrary::DoesImplementInterface(actor, PickupInterface))
 		{
-			auto pos = actor->GetActorLocation();
-			auto dist = FVector::DistSquared(handPos, pos);
-
-			if (dist < nearest)
-			{
-				nearestActor = actor;
-				nearest = dist;
-			}
+			pickups.Add(actor);
+			pickupPositions.Add(ToCore(actor->GetActorLocation()));
 		}
 	}
 
-	return nearestActor;
+	int nearest = VRTestCore::NearestPoint(ToCore(GrabSphere->GetComponentLocation()), pickupPositions.GetData(), pickupPositions.Num());
+
+	return nearest == -1 ? nullptr : pickups[nearest];
 }
 
 //---------------------------------------------------------------------------------------------------------------------
 void AVRMotionController::GrabActor()
 {
+	VR_RECORD_SCOPE(EVRFrameEvent::Grab, (uint32)Hand);
+	VRTEST_LLM_SCOPE(Grab);
+
 	wantsToGrip = true;
+	SetGripCollision(true);
 
 	if (GrabbedActor != nullptr)
 	{
@@ -197,7 +271,11 @@ void AVRMotionController::GrabActor()
 //---------------------------------------------------------------------------------------------------------------------
 void AVRMotionController::ReleaseActor()
 {
+	VR_RECORD_SCOPE(EVRFrameEvent::Release, (uint32)Hand);
+	VRTEST_LLM_SCOPE(Grab);
+
 	wantsToGrip = false;
+	SetGripCollision(false);
 
 	if (GrabbedActor != nullptr)
 	{
@@ -210,49 +288,67 @@ void AVRMotionController::ReleaseActor()
 	}
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+void AVRMotionController::SetGripCollision(bool gripping)
+{
+	if (!UseSimpleHandCollision)
+	{
+		HandMesh->SetCollisionEnabled(gripping ? ECollisionEnabled::QueryAndPhysics : ECollisionEnabled::NoCollision);
+		return;
+	}
+
+	// Only the filter data changes, none of the bodies are recreated
+	ECollisionResponse response = gripping ? ECR_Block : ECR_Ignore;
+
+	PalmCollision->SetCollisionResponseToAllChannels(response);
+	for (int i = 0; i < FingerCollision.Num(); i++)
+	{
+		FingerCollision[i]->SetCollisionResponseToAllChannels(response);
+	}
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 void AVRMotionController::ActivateTeleporter()
 {
-	TeleportCylinder->SetVisibility(true, true);
 	isTeleporterActive = true;
 }
 
 //---------------------------------------------------------------------------------------------------------------------
 void AVRMotionController::DeactivateTeleporter()
 {
-	TeleportCylinder->SetVisibility(false, true);
-	ArcEndPoint->SetVisibility(false);
 	isTeleporterActive = false;
 }
 
 //---------------------------------------------------------------------------------------------------------------------
 bool AVRMotionController::TraceTeleportDestination(FTeleportTraceResult& _result)
 {
-	FPredictProjectilePathParams params;
-	params.StartLocation = ArcDirection->GetComponentLocation();
-	params.LaunchVelocity = ArcDirection->GetForwardVector() * 10.0f;
-	params.bTraceWithCollision = true;
-	params.ProjectileRadius = 0.0f;
-	params.ObjectTypes.Add(UEngineTypes::ConvertToObjectType(ECollisionChannel::ECC_WorldStatic));
-	params.bTraceComplex = false;
-
-	FPredictProjectilePathResult result;
+	VRTEST_LLM_SCOPE(TeleportArc);
 
-	bool collided = UGameplayStatics::PredictProjectilePath(GetWorld(), params, result);
+	_result.TracePoints.Reset();
 
-	for (int i = 0; i < result.PathData.Num(); i++)
+	if (UseTargetAssist)
 	{
-		_result.TracePoints.Add(result.PathData[i].Location);
+		return TraceAssistedTeleportDestination(_result);
 	}
 
+	SCOPE_CYCLE_COUNTER(STAT_TraceTeleportArc);
+	INC_DWORD_STAT(STAT_TeleportArcsTraced);
+
+	PrepareArcs(1);
+
+	auto& arc = arcs[0];
+	TraceArc(GetWorld(), ArcDirection->GetComponentLocation(), ArcDirection->GetForwardVector() * VRTestCore::ArcLaunchSpeed, GetWorld()->GetGravityZ(), arc);
+
+	_result.TracePoints.Append(arc.Points, arc.NumPoints);
+
+	bool collided = arc.Hit;
+
 	if (collided)
 	{
-		_result.TraceLocation = result.LastTraceDestination.Location;
-
-		auto navigationSystem = UNavigationSystem::GetNavigationSystem(GetWorld());
+		_result.TraceLocation = arc.EndLocation;
 
 		FVector pos;
-		collided = UNavigationSystem::K2_ProjectPointToNavigation(GetWorld(), result.LastTraceDestination.Location, pos, nullptr, 0, FVector(1.0f));
+		collided = UNavigationSystem::K2_ProjectPointToNavigation(GetWorld(), arc.EndLocation, pos, nullptr, 0, FVector(1.0f));
 
 		if (collided)
 		{
@@ -264,69 +360,158 @@ bool AVRMotionController::TraceTeleportDestination(FTeleportTraceResult& _result
 }
 
 //---------------------------------------------------------------------------------------------------------------------
-void AVRMotionController::ClearArc()
+bool AVRMotionController::TraceAssistedTeleportDestination(FTeleportTraceResult& _result)
 {
-	for (int i = 0; i < SplineMeshes.Num(); i++)
+	SCOPE_CYCLE_COUNTER(STAT_TraceTeleportArcFan);
+
+	const double startTime = FPlatformTime::Seconds();
+
+	const FVector start = ArcDirection->GetComponentLocation();
+	const FVector aim = ArcDirection->GetForwardVector();
+	const FVector up = ArcDirection->GetUpVector();
+
+	// Arc 0 is the primary aim. Only as many arcs as last frame's cost says fit in the budget are traced.
+	const int32 requestedArcs = FMath::Clamp(TargetAssistArcCount, 1, MaxTargetAssistArcs) + 1;
+	const int32 numArcs = VRTestCore::ArcCountForBudget(requestedArcs, TargetAssistBudgetMs, targetAssistCostPerArcMs);
+	SET_DWORD_STAT(STAT_TeleportArcsInFan, numArcs);
+
+	PrepareArcs(numArcs);
+
+	bool collided[MaxTargetAssistArcs + 1];
+
+	// Scene queries are safe off the game thread, so each arc gets its own worker
+	UWorld* world = GetWorld();
+	const float gravityZ = world->GetGravityZ();
+	ParallelFor(numArcs, [&](int32 i)
+	{
+		auto direction = VRTestCore::ArcFanDirection(ToCore(aim), ToCore(up), TargetAssistConeAngle, i, numArcs);
+		TraceArc(world, start, FromCore(direction) * VRTestCore::ArcLaunchSpeed, gravityZ, arcs[i]);
+		collided[i] = arcs[i].Hit;
+	}, !TargetAssistParallel);
+
+	INC_DWORD_STAT_BY(STAT_TeleportArcsTraced, numArcs);
+
+	SCOPE_CYCLE_COUNTER(STAT_ScoreTeleportArcFan);
+
+	// Navigation queries stay on the game thread
+	const bool primaryHit = collided[0];
+	VRTestCore::Vec3 navMeshLocations[MaxTargetAssistArcs + 1];
+	for (int i = 0; i < numArcs; i++)
 	{
-		SplineMeshes[i]->DestroyComponent();
+		if (collided[i])
+		{
+			FVector pos;
+			collided[i] = UNavigationSystem::K2_ProjectPointToNavigation(world, arcs[i].EndLocation, pos, nullptr, 0, FVector(1.0f));
+			navMeshLocations[i] = ToCore(pos);
+		}
 	}
-	SplineMeshes.Empty();
 
-	ArcSpline->ClearSplinePoints();
+	// Without a primary hit its path just ends in the air, so fall back to the arc closest in angle to the aim
+	int32 bestArc = primaryHit
+		? VRTestCore::SelectBestArc(ToCore(arcs[0].EndLocation), collided, navMeshLocations, numArcs)
+		: VRTestCore::SelectBestArcByAngle(collided, numArcs);
+
+	// Smoothed so one slow frame doesn't collapse the fan
+	const float costPerArcMs = (float)((FPlatformTime::Seconds() - startTime) * 1000.0) / numArcs;
+	targetAssistCostPerArcMs = targetAssistCostPerArcMs > 0.0f ? FMath::Lerp(targetAssistCostPerArcMs, costPerArcMs, 0.2f) : costPerArcMs;
+
+	const FTeleportArc& shownArc = arcs[bestArc == INDEX_NONE ? 0 : bestArc];
+	_result.TracePoints.Append(shownArc.Points, shownArc.NumPoints);
+
+	if (bestArc == INDEX_NONE)
+	{
+		return false;
+	}
+
+	_result.TraceLocation = shownArc.EndLocation;
+	_result.NavMeshLocation = FromCore(navMeshLocations[bestArc]);
+
+	return true;
 }
 
 //---------------------------------------------------------------------------------------------------------------------
-void AVRMotionController::UpdateArcSpline(bool foundValidLocation, TArray<FVector> splinePoints)
+void AVRMotionController::PrepareArcs(int32 numArcs)
 {
-	if (!foundValidLocation)
+	// Kept between frames so tracing reuses the same point buffers
+	if (arcs.Num() < numArcs)
 	{
-		splinePoints.Empty();
-
-		splinePoints.Add(ArcDirection->GetComponentLocation());
-		splinePoints.Add(ArcDirection->GetComponentLocation() + ArcDirection->GetForwardVector() * 20.0f);
+		arcs.SetNum(numArcs);
 	}
+}
 
-	for (int i = 0; i < splinePoints.Num(); i++)
-	{
-		auto point = splinePoints[i];
-		ArcSpline->AddSplinePoint(point, ESplineCoordinateSpace::Local);
-	}
+//---------------------------------------------------------------------------------------------------------------------
+bool AVRMotionController::IsHandLocallyControlled() const
+{
+	// Hands that aren't owned by a pawn are treated as the local player's
+	auto pawn = Cast<APawn>(GetOwner());
+	return pawn == nullptr || pawn->IsLocallyControlled();
+}
 
-	ArcSpline->SetSplinePointType(splinePoints.Num() - 1, ESplinePointType::CurveClamped);
+//---------------------------------------------------------------------------------------------------------------------
+void AVRMotionController::ApplyHandLODPolicy(bool isLocal)
+{
+	VRTEST_LLM_SCOPE(HandVisuals);
 
-	for (int i = 0; i < ArcSpline->GetNumberOfSplinePoints() - 2; i++)
-	{
-		auto splineMesh = NewObject<USplineMeshComponent>();
-		SplineMeshes.Add(splineMesh);
-		splineMesh->AttachToComponent(ArcSpline, FAttachmentTransformRules::KeepWorldTransform);
+	isLocalHand = isLocal;
+
+	// Local hands are right in front of the HMD so always animate at full rate and detail.
+	// Remote hands only animate when rendered, at a rate driven by screen size, and skip the highest LODs.
+	HandMesh->VisibilityBasedAnimTickOption = isLocal ? EMeshComponentUpdateFlag::AlwaysTickPoseAndRefreshBones : EMeshComponentUpdateFlag::OnlyTickPoseWhenRendered;
+	HandMesh->MinLodModel = isLocal ? 0 : RemoteHandMinLOD;
 
-		splineMesh->SetStartAndEnd(
-			splinePoints[i], ArcSpline->GetTangentAtSplinePoint(i, ESplineCoordinateSpace::Local),
-			splinePoints[i + 1], ArcSpline->GetTangentAtSplinePoint(i + 1, ESplineCoordinateSpace::Local));
+	if (HandMesh->bEnableUpdateRateOptimizations != !isLocal)
+	{
+		// Update rate parameters are only picked up on registration
+		HandMesh->bEnableUpdateRateOptimizations = !isLocal;
+		if (HandMesh->IsRegistered())
+		{
+			HandMesh->ReregisterComponent();
+		}
 	}
+
+	handIdleTime = 0.0f;
+	idleAnchorLocation = MotionController->GetComponentLocation();
+	lastWantsToGrip = wantsToGrip;
+	SetHandPoseFrozen(false);
 }
 
 //---------------------------------------------------------------------------------------------------------------------
-void AVRMotionController::UpdateArcEndpoint(FVector newLocation, bool validLocationFound)
+void AVRMotionController::SetHandPoseFrozen(bool frozen)
 {
-	ArcEndPoint->SetVisibility(validLocationFound && isTeleporterActive);
-	ArcEndPoint->SetWorldLocation(newLocation, false, nullptr, ETeleportType::TeleportPhysics);
-
-	FRotator rot;
-	FVector pos;
-	UHeadMountedDisplayFunctionLibrary::GetOrientationAndPosition(rot, pos);
+	if (frozen == isHandPoseFrozen)
+	{
+		return;
+	}
 
-	Arrow->SetWorldRotation(FRotator(0, rot.Yaw, 0));
+	// A frozen hand keeps its last evaluated pose and does no animation or bone work
+	isHandPoseFrozen = frozen;
+	HandMesh->bPauseAnims = frozen;
+	HandMesh->bNoSkeletonUpdate = frozen;
 }
 
 //---------------------------------------------------------------------------------------------------------------------
-FVector AVRMotionController::GetTeleportDestination()
+void AVRMotionController::UpdateHandIdle(float DeltaTime)
 {
-	FRotator rot;
-	FVector pos;
-	UHeadMountedDisplayFunctionLibrary::GetOrientationAndPosition(rot, pos);
+	// Movement is measured from where the hand came to rest rather than frame to frame,
+	// so slow drift still wakes the hand however high the frame rate is
+	auto handLocation = MotionController->GetComponentLocation();
+	bool moved = FVector::DistSquared(handLocation, idleAnchorLocation) > RemoteHandIdleDistance * RemoteHandIdleDistance;
+	bool gripChanged = wantsToGrip != lastWantsToGrip;
 
-	FVector offset = FVector(pos.X, pos.Y, 0.0f);
+	lastWantsToGrip = wantsToGrip;
 
-	return TeleportCylinder->GetComponentLocation() - offset;
-}
\ No newline at end of file
+	if (moved || gripChanged)
+	{
+		idleAnchorLocation = handLocation;
+		handIdleTime = 0.0f;
+		SetHandPoseFrozen(false);
+	}
+	else
+	{
+		handIdleTime += DeltaTime;
+		if (handIdleTime >= RemoteHandIdleTime)
+		{
+			SetHandPoseFrozen(true);
+		}
+	}
+}
@@ -10,7 +10,10 @@
 #include "Components/SplineComponent.h"
 #include <Components/SplineMeshComponent.h>
 #include "Components/SphereComponent.h"
+#include "Components/BoxComponent.h"
+#include "Components/CapsuleComponent.h"
 #include "Components/StaticMeshComponent.h"
+#include "VRTestCore/Teleport.h"
 #include "VRMotionController.generated.h"
 
 struct FTeleportTraceResult
@@ -20,6 +23,17 @@ struct FTeleportTraceResult
 	FVector TraceLocation;
 };
 
+/* One traced teleport arc, kept between frames so tracing never allocates */
+struct FTeleportArc
+{
+	FVector Points[VRTestCore::ArcMaxPoints];
+	int32 NumPoints;
+
+	/* Where the arc hit the world, or its last point if it didn't */
+	FVector EndLocation;
+	bool Hit;
+};
+
 UCLASS()
 class VRTEST_API AVRMotionController : public AActor
 {
@@ -42,27 +56,59 @@ public:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
 	class UArrowComponent* ArcDirection;
 
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
-	class USplineComponent* ArcSpline;
-
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
 	class USphereComponent* GrabSphere;
 
+	/* Simple collision used while gripping instead of the hand's physics asset */
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
-	class UStaticMeshComponent* ArcEndPoint;
-
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
-	class UStaticMeshComponent* TeleportCylinder;
+	class UBoxComponent* PalmCollision;
 
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
-	class UStaticMeshComponent* Ring;
-
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
-	class UStaticMeshComponent* Arrow;
+	TArray<class UCapsuleComponent*> FingerCollision;
 
 	UPROPERTY(VisibleAnywhere, Category = "Grabbing")
 	AActor* GrabbedActor;
 
+	/* Blueprint interface implemented by actors that can be picked up */
+	UPROPERTY(VisibleAnywhere, Category = "Grabbing")
+	UClass* PickupInterface;
+
+	/* Evaluate a fan of arcs around ArcDirection and snap to the best valid nav location */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Teleportation")
+	bool UseTargetAssist;
+
+	/* Number of candidate arcs in the target assist fan, in addition to the primary arc */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Teleportation", meta = (ClampMin = "1", ClampMax = "32"))
+	int32 TargetAssistArcCount;
+
+	/* Half angle of the target assist fan, in degrees */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Teleportation", meta = (ClampMin = "0.0", ClampMax = "45.0"))
+	float TargetAssistConeAngle;
+
+	/* Time the whole fan may take per frame, in ms. The fan shrinks to fit based on the measured cost per arc. 0 disables the budget. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Teleportation", meta = (ClampMin = "0.0"))
+	float TargetAssistBudgetMs;
+
+	/* Trace the fan's arcs on worker threads. Off runs them all on the game thread, mainly for comparison. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Teleportation")
+	bool TargetAssistParallel;
+
+	/* Collide with the palm and finger primitives while gripping, rather than the skeletal mesh's physics asset */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Grabbing")
+	bool UseSimpleHandCollision;
+
+	/* Seconds a remote hand has to stay still before its pose is frozen */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Hand LOD")
+	float RemoteHandIdleTime;
+
+	/* Distance in cm a remote hand has to move away from where it came to rest to count as active, independent of frame rate */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Hand LOD")
+	float RemoteHandIdleDistance;
+
+	/* Highest detail LOD evaluated for remote hands */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Hand LOD")
+	int32 RemoteHandMinLOD;
+
 public:
 	UFUNCTION(BlueprintCallable)
 	void RumbleController(float _intensity);
@@ -76,6 +122,9 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Grabbing")
 	void ReleaseActor();
 
+	UFUNCTION(BlueprintCallable, Category = "Grabbing")
+	void SetGripCollision(bool gripping);
+
 	UFUNCTION(BlueprintCallable, Category = "Teleportation")
 	void ActivateTeleporter();
 
@@ -85,17 +134,21 @@ public:
 	//UFUNCTION(BlueprintCallable, Category = "Teleportation")
 	bool TraceTeleportDestination(FTeleportTraceResult& result);
 
-	UFUNCTION(BlueprintCallable, Category = "Teleportation")
-	void ClearArc();
+	//UFUNCTION(BlueprintCallable, Category = "Teleportation")
+	bool TraceAssistedTeleportDestination(FTeleportTraceResult& result);
 
-	UFUNCTION(BlueprintCallable, Category = "Teleportation")
-	void UpdateArcSpline(bool foundValidLocation, TArray<FVector> splinePoints);
+	UFUNCTION(BlueprintCallable, Category = "Hand LOD")
+	bool IsHandLocallyControlled() const;
 
-	UFUNCTION(BlueprintCallable, Category = "Teleportation")
-	void UpdateArcEndpoint(FVector newLocation, bool validLocationFound);
+	UFUNCTION(BlueprintCallable, Category = "Hand LOD")
+	void ApplyHandLODPolicy(bool isLocal);
 
-	UFUNCTION(BlueprintCallable, Category = "Teleportation")
-	FVector GetTeleportDestination();
+	UFUNCTION(BlueprintCallable, Category = "Hand LOD")
+	void SetHandPoseFrozen(bool frozen);
+
+	void UpdateHandIdle(float DeltaTime);
+
+	void PrepareArcs(int32 numArcs);
 	
 public:	
 	// Sets default values for this actor's properties
@@ -109,9 +162,16 @@ public:
 	// Called every frame
 	virtual void Tick(float DeltaTime) override;
 
-	TArray<USplineMeshComponent*> SplineMeshes;
-
 	bool wantsToGrip;
 	bool isTeleporterActive;
-	bool isValidTeleportDest;
+
+	bool isLocalHand;
+	bool isHandPoseFrozen;
+	float handIdleTime;
+	FVector idleAnchorLocation;
+	bool lastWantsToGrip;
+
+	float targetAssistCostPerArcMs;
+
+	TArray<FTeleportArc> arcs;
 };
@@ -1,6 +1,7 @@
 // Fill out your copyright notice in the Description page of Project Settings.
 
 using UnrealBuildTool;
+using System.IO;
 
 public class VRTest : ModuleRules
 {
@@ -12,6 +13,9 @@ public class VRTest : ModuleRules
 
 		PrivateDependencyModuleNames.AddRange(new string[] {  });
 
+		// Engine-free interaction math, header only
+		PublicIncludePaths.Add(Path.Combine(ModuleDirectory, "..", "VRTestCore", "Public"));
+
 		// Uncomment if you are using Slate UI
 		// PrivateDependencyModuleNames.AddRange(new string[] { "Slate", "SlateCore" });
 		
@@ -2,5 +2,34 @@
 
 #include "VRTest.h"
 #include "Modules/ModuleManager.h"
+#include "VRFrameRecorder.h"
 
-IMPLEMENT_PRIMARY_GAME_MODULE( FDefaultGameModuleImpl, VRTest, "VRTest" );
+#if ENABLE_LOW_LEVEL_MEM_TRACKER
+DECLARE_LLM_MEMORY_STAT(TEXT("VRTeleportArc"), STAT_VRTeleportArcLLM, STATGROUP_LLMFULL);
+DECLARE_LLM_MEMORY_STAT(TEXT("VRGrab"), STAT_VRGrabLLM, STATGROUP_LLMFULL);
+DECLARE_LLM_MEMORY_STAT(TEXT("VRHandVisuals"), STAT_VRHandVisualsLLM, STATGROUP_LLMFULL);
+DECLARE_LLM_MEMORY_STAT(TEXT("VRLocomotion"), STAT_VRLocomotionLLM, STATGROUP_LLMFULL);
+#endif
+
+class FVRTestModule : public FDefaultGameModuleImpl
+{
+	virtual void StartupModule() override
+	{
+#if ENABLE_LOW_LEVEL_MEM_TRACKER
+		FLowLevelMemTracker& tracker = FLowLevelMemTracker::Get();
+		tracker.RegisterProjectTag((int32)EVRTestLLMTag::TeleportArc, TEXT("VRTeleportArc"), GET_STATFNAME(STAT_VRTeleportArcLLM), NAME_None);
+		tracker.RegisterProjectTag((int32)EVRTestLLMTag::Grab, TEXT("VRGrab"), GET_STATFNAME(STAT_VRGrabLLM), NAME_None);
+		tracker.RegisterProjectTag((int32)EVRTestLLMTag::HandVisuals, TEXT("VRHandVisuals"), GET_STATFNAME(STAT_VRHandVisualsLLM), NAME_None);
+		tracker.RegisterProjectTag((int32)EVRTestLLMTag::Locomotion, TEXT("VRLocomotion"), GET_STATFNAME(STAT_VRLocomotionLLM), NAME_None);
+#endif
+
+		FVRFrameRecorder::Get().Startup();
+	}
+
+	virtual void ShutdownModule() override
+	{
+		FVRFrameRecorder::Get().Shutdown();
+	}
+};
+
+IMPLEMENT_PRIMARY_GAME_MODULE( FVRTestModule, VRTest, "VRTest" );
@@ -3,4 +3,36 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "HAL/LowLevelMemTracker.h"
+#include "VRTestCore/Vec3.h"
 
+DECLARE_STATS_GROUP(TEXT("VRTest"), STATGROUP_VRTest, STATCAT_Advanced);
+
+#if ENABLE_LOW_LEVEL_MEM_TRACKER
+
+/* Low level memory tracker tags for the module's subsystems, run with -LLM to see them in stat LLMFULL */
+enum class EVRTestLLMTag : int32
+{
+	TeleportArc = (int32)ELLMTag::ProjectTagStart,
+	Grab,
+	HandVisuals,
+	Locomotion,
+};
+
+#define VRTEST_LLM_SCOPE(Tag) LLM_SCOPE((ELLMTag)EVRTestLLMTag::Tag)
+
+#else
+
+#define VRTEST_LLM_SCOPE(Tag)
+
+#endif
+
+FORCEINLINE VRTestCore::Vec3 ToCore(const FVector& v)
+{
+	return VRTestCore::Vec3(v.X, v.Y, v.Z);
+}
+
+FORCEINLINE FVector FromCore(const VRTestCore::Vec3& v)
+{
+	return FVector(v.X, v.Y, v.Z);
+}
@@ -0,0 +1,80 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+// Times the engine-free part of the target assist fan (directions, ballistic sampling, ground hit and scoring) across fan sizes.
+// Collision, nav projection and ParallelFor are not included, see the VRTest.Perf.TargetAssistFan automation test for those.
+// Usage: VRTestCoreBenchmark [iterations]
+
+#include "VRTestCore/Teleport.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+using namespace VRTestCore;
+
+static const int MaxArcPoints = 64;
+static const float GravityZ = -980.0f;
+static const float FloorZ = -150.0f;
+
+/* One fan evaluation, returns the chosen arc so the work can't be optimized away */
+static int EvaluateFan(const Vec3& start, const Vec3& aim, const Vec3& up, int numArcs, std::vector<Vec3>& points, std::vector<Vec3>& hits, bool* valid)
+{
+	for (int i = 0; i < numArcs; i++)
+	{
+		Vec3 direction = ArcFanDirection(aim, up, 15.0f, i, numArcs);
+		Vec3* arc = &points[i * MaxArcPoints];
+		int count = SampleBallisticArc(start, direction * 600.0f, GravityZ, arc, MaxArcPoints);
+
+		// Stand-in for the collision trace, a flat floor
+		valid[i] = false;
+		for (int p = 1; p < count; p++)
+		{
+			if (arc[p].Z <= FloorZ)
+			{
+				hits[i] = arc[p];
+				valid[i] = true;
+				break;
+			}
+		}
+	}
+
+	return SelectBestArc(hits[0], valid, hits.data(), numArcs);
+}
+
+int main(int argc, char** argv)
+{
+	const int iterations = argc > 1 ? std::atoi(argv[1]) : 20000;
+	const int fanSizes[] = { 8, 16, 32 };
+
+	const Vec3 start(0.0f, 0.0f, 0.0f);
+	const Vec3 aim = SafeNormal(Vec3(1.0f, 0.0f, 0.2f));
+	const Vec3 up = SafeNormal(Cross(Cross(aim, Vec3(0.0f, 0.0f, 1.0f)), aim));
+
+	std::printf("%8s %12s %12s %12s\n", "arcs", "us/fan", "us/arc", "iterations");
+
+	for (int fanSize : fanSizes)
+	{
+		// Fan size plus the primary arc, as in AVRMotionController::TraceAssistedTeleportDestination
+		const int numArcs = fanSize + 1;
+
+		std::vector<Vec3> points(numArcs * MaxArcPoints);
+		std::vector<Vec3> hits(numArcs);
+		// Not std::vector<bool>, SelectBestArc takes a plain bool array
+		std::unique_ptr<bool[]> valid(new bool[numArcs]);
+
+		volatile int sink = 0;
+		auto begin = std::chrono::steady_clock::now();
+		for (int i = 0; i < iterations; i++)
+		{
+			sink += EvaluateFan(start, aim, up, numArcs, points, hits, valid.get());
+		}
+		auto end = std::chrono::steady_clock::now();
+
+		double us = std::chrono::duration<double, std::micro>(end - begin).count() / iterations;
+		std::printf("%8d %12.3f %12.3f %12d\n", fanSize, us, us / numArcs, iterations);
+	}
+
+	return 0;
+}
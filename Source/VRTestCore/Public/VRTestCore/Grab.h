@@ -0,0 +1,27 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "VRTestCore/Vec3.h"
+
+namespace VRTestCore
+{
+	/* Index of the point nearest to 'origin', or -1 if there are none */
+	inline int NearestPoint(const Vec3& origin, const Vec3* points, int count)
+	{
+		int nearest = -1;
+		float nearestDist = 0.0f;
+
+		for (int i = 0; i < count; i++)
+		{
+			const float dist = DistSquared(origin, points[i]);
+			if (nearest == -1 || dist < nearestDist)
+			{
+				nearest = i;
+				nearestDist = dist;
+			}
+		}
+
+		return nearest;
+	}
+}
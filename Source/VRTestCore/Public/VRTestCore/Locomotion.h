@@ -0,0 +1,14 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "VRTestCore/Vec3.h"
+
+namespace VRTestCore
+{
+	/* Flattens a controller axis into the direction thumbstick movement is applied along */
+	inline Vec3 MoveDirection(const Vec3& controllerAxis)
+	{
+		return SafeNormal(Vec3(controllerAxis.X, 0.0f, controllerAxis.Z));
+	}
+}
@@ -0,0 +1,160 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "VRTestCore/Vec3.h"
+
+namespace VRTestCore
+{
+	/* Speed the teleport arc is launched at along the aim direction */
+	const float ArcLaunchSpeed = 10.0f;
+
+	/* Length of the stub arc shown when no valid destination was found */
+	const float InvalidArcLength = 20.0f;
+
+	/**
+	 * Direction of arc 'index' in a target assist fan of 'count' arcs around 'aim'.
+	 * Arc 0 is the aim itself, the rest alternate between an inner ring at half the cone angle and an outer ring at the full cone angle.
+	 * ArcFanRing gives that fraction of the cone angle for an arc.
+	 */
+	inline float ArcFanRing(int index)
+	{
+		return index == 0 ? 0.0f : ((index % 2 == 0) ? 1.0f : 0.5f);
+	}
+
+	inline Vec3 ArcFanDirection(const Vec3& aim, const Vec3& up, float coneAngleDeg, int index, int count)
+	{
+		if (index == 0 || count < 2)
+		{
+			return aim;
+		}
+
+		const float ringScale = ArcFanRing(index);
+		const float azimuth = 360.0f * (index - 1) / (count - 1);
+
+		return RotateAngleAxis(RotateAngleAxis(aim, coneAngleDeg * ringScale, up), azimuth, aim);
+	}
+
+	/**
+	 * Picks the valid candidate whose nav location is closest to where the primary arc landed.
+	 * Returns -1 if no candidate is valid.
+	 */
+	inline int SelectBestArc(const Vec3& aimLocation, const bool* valid, const Vec3* navLocations, int count)
+	{
+		int best = -1;
+		float bestScore = 0.0f;
+
+		for (int i = 0; i < count; i++)
+		{
+			if (!valid[i])
+			{
+				continue;
+			}
+
+			const float score = DistSquared(navLocations[i], aimLocation);
+			if (best == -1 || score < bestScore)
+			{
+				best = i;
+				bestScore = score;
+			}
+		}
+
+		return best;
+	}
+
+	/**
+	 * Picks the valid candidate closest in angle to the aim: the primary arc, then the inner ring, then the outer ring.
+	 * Used when the primary arc hit nothing, so there is no landing point to score against. Returns -1 if no candidate is valid.
+	 */
+	inline int SelectBestArcByAngle(const bool* valid, int count)
+	{
+		int best = -1;
+
+		for (int i = 0; i < count; i++)
+		{
+			if (valid[i] && (best == -1 || ArcFanRing(i) < ArcFanRing(best)))
+			{
+				best = i;
+			}
+		}
+
+		return best;
+	}
+
+	/**
+	 * How many arcs, primary included, fit in budgetMs when each costs costPerArcMs.
+	 * Never drops the primary arc, and returns 'requested' when the budget or cost is not known yet.
+	 */
+	inline int ArcCountForBudget(int requested, float budgetMs, float costPerArcMs)
+	{
+		if (budgetMs <= 0.0f || costPerArcMs <= 0.0f)
+		{
+			return requested;
+		}
+
+		const float affordable = budgetMs / costPerArcMs;
+		if (affordable < 1.0f)
+		{
+			return 1;
+		}
+
+		return affordable < (float)requested ? (int)affordable : requested;
+	}
+
+	/* Simulation defaults, the same as FPredictProjectilePathParams */
+	const float ArcSimFrequency = 20.0f;
+	const float ArcMaxSimTime = 2.0f;
+
+	/* Points in an arc sampled with the defaults, the start plus one per substep */
+	const int ArcMaxPoints = 41;
+
+	/**
+	 * Samples a ballistic arc the same way UGameplayStatics::PredictProjectilePath steps it, without any collision.
+	 * The caller traces between consecutive points to find where the arc lands.
+	 * Writes the start point followed by one point per substep, returns the number of points written.
+	 */
+	inline int SampleBallisticArc(const Vec3& start, const Vec3& velocity, float gravityZ, Vec3* outPoints, int maxPoints,
+		float simFrequency = ArcSimFrequency, float maxSimTime = ArcMaxSimTime)
+	{
+		if (maxPoints <= 0)
+		{
+			return 0;
+		}
+
+		const float substep = 1.0f / simFrequency;
+
+		Vec3 position = start;
+		Vec3 currentVelocity = velocity;
+		float time = 0.0f;
+		int count = 0;
+
+		outPoints[count++] = position;
+		// The tolerance stops float drift in 'time' from adding a near zero length final step
+		while (maxSimTime - time > 1.e-4f && count < maxPoints)
+		{
+			const float dt = (maxSimTime - time) < substep ? (maxSimTime - time) : substep;
+			time += dt;
+
+			// Trapezoidal integration, matching the engine's path prediction
+			const Vec3 oldVelocity = currentVelocity;
+			currentVelocity = oldVelocity + Vec3(0.0f, 0.0f, gravityZ * dt);
+			position = position + (oldVelocity + currentVelocity) * (0.5f * dt);
+
+			outPoints[count++] = position;
+		}
+
+		return count;
+	}
+
+	/* End of the stub arc shown when no valid destination was found */
+	inline Vec3 InvalidArcEnd(const Vec3& start, const Vec3& direction)
+	{
+		return start + direction * InvalidArcLength;
+	}
+
+	/* Where to put the actor so the HMD, rather than the play space origin, ends up over the destination */
+	inline Vec3 TeleportDestination(const Vec3& target, const Vec3& hmdPosition)
+	{
+		return target - Vec3(hmdPosition.X, hmdPosition.Y, 0.0f);
+	}
+}
@@ -0,0 +1,70 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include <cmath>
+
+namespace VRTestCore
+{
+	/**
+	 * Minimal engine-free vector with the same component order and conventions as FVector
+	 */
+	struct Vec3
+	{
+		float X;
+		float Y;
+		float Z;
+
+		Vec3() : X(0.0f), Y(0.0f), Z(0.0f) {}
+		Vec3(float x, float y, float z) : X(x), Y(y), Z(z) {}
+
+		Vec3 operator+(const Vec3& o) const { return Vec3(X + o.X, Y + o.Y, Z + o.Z); }
+		Vec3 operator-(const Vec3& o) const { return Vec3(X - o.X, Y - o.Y, Z - o.Z); }
+		Vec3 operator*(float s) const { return Vec3(X * s, Y * s, Z * s); }
+	};
+
+	inline float Dot(const Vec3& a, const Vec3& b)
+	{
+		return a.X * b.X + a.Y * b.Y + a.Z * b.Z;
+	}
+
+	inline Vec3 Cross(const Vec3& a, const Vec3& b)
+	{
+		return Vec3(a.Y * b.Z - a.Z * b.Y, a.Z * b.X - a.X * b.Z, a.X * b.Y - a.Y * b.X);
+	}
+
+	inline float SizeSquared(const Vec3& v)
+	{
+		return Dot(v, v);
+	}
+
+	inline float DistSquared(const Vec3& a, const Vec3& b)
+	{
+		return SizeSquared(a - b);
+	}
+
+	/* Matches FVector::GetSafeNormal, returns zero for vectors too small to normalize */
+	inline Vec3 SafeNormal(const Vec3& v, float tolerance = 1.e-8f)
+	{
+		const float squareSum = SizeSquared(v);
+		if (squareSum == 1.0f)
+		{
+			return v;
+		}
+		if (squareSum < tolerance)
+		{
+			return Vec3();
+		}
+		return v * (1.0f / std::sqrt(squareSum));
+	}
+
+	/* Matches FVector::RotateAngleAxis, axis is expected to be normalized */
+	inline Vec3 RotateAngleAxis(const Vec3& v, float angleDeg, const Vec3& axis)
+	{
+		const float rad = angleDeg * (3.14159265358979323846f / 180.0f);
+		const float s = std::sin(rad);
+		const float c = std::cos(rad);
+
+		return v * c + Cross(axis, v) * s + axis * (Dot(axis, v) * (1.0f - c));
+	}
+}
@@ -0,0 +1,210 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "VRTestCore/Grab.h"
+#include "VRTestCore/Locomotion.h"
+#include "VRTestCore/Teleport.h"
+
+#include <cmath>
+#include <cstdio>
+
+using namespace VRTestCore;
+
+static int Failures = 0;
+
+#define CHECK(Expr) \
+	do { if (!(Expr)) { std::printf("%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #Expr); Failures++; } } while (0)
+
+static bool NearlyEqual(float a, float b, float tolerance = 1.e-4f)
+{
+	return std::fabs(a - b) <= tolerance;
+}
+
+static bool NearlyEqual(const Vec3& a, const Vec3& b, float tolerance = 1.e-4f)
+{
+	return NearlyEqual(a.X, b.X, tolerance) && NearlyEqual(a.Y, b.Y, tolerance) && NearlyEqual(a.Z, b.Z, tolerance);
+}
+
+static float AngleBetweenDeg(const Vec3& a, const Vec3& b)
+{
+	float c = Dot(SafeNormal(a), SafeNormal(b));
+	c = c > 1.0f ? 1.0f : (c < -1.0f ? -1.0f : c);
+	return std::acos(c) * (180.0f / 3.14159265358979323846f);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+static void TestRotateAngleAxis()
+{
+	// Reference values from FVector::RotateAngleAxis
+	CHECK(NearlyEqual(RotateAngleAxis(Vec3(1, 0, 0), 90.0f, Vec3(0, 0, 1)), Vec3(0, 1, 0)));
+	CHECK(NearlyEqual(RotateAngleAxis(Vec3(1, 0, 0), 90.0f, Vec3(0, 1, 0)), Vec3(0, 0, -1)));
+	CHECK(NearlyEqual(RotateAngleAxis(Vec3(0, 1, 0), 180.0f, Vec3(1, 0, 0)), Vec3(0, -1, 0)));
+	CHECK(NearlyEqual(RotateAngleAxis(Vec3(1, 2, 3), 0.0f, Vec3(0, 0, 1)), Vec3(1, 2, 3)));
+	CHECK(NearlyEqual(RotateAngleAxis(Vec3(1, 0, 0), 45.0f, Vec3(0, 0, 1)), Vec3(0.707107f, 0.707107f, 0)));
+
+	// Components along the axis are untouched
+	CHECK(NearlyEqual(RotateAngleAxis(Vec3(0, 0, 5), 73.0f, Vec3(0, 0, 1)), Vec3(0, 0, 5)));
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+static void TestSafeNormal()
+{
+	// Reference values from FVector::GetSafeNormal
+	CHECK(NearlyEqual(SafeNormal(Vec3(3, 0, 4)), Vec3(0.6f, 0, 0.8f)));
+	CHECK(NearlyEqual(SafeNormal(Vec3(0, 0, 1)), Vec3(0, 0, 1)));
+	CHECK(NearlyEqual(SafeNormal(Vec3(0, 0, 0)), Vec3(0, 0, 0)));
+	CHECK(NearlyEqual(SafeNormal(Vec3(1.e-5f, 0, 0)), Vec3(0, 0, 0)));
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+static void TestArcFanDirection()
+{
+	const Vec3 aim = SafeNormal(Vec3(1, 0, 0.3f));
+	const Vec3 up = SafeNormal(Cross(Cross(aim, Vec3(0, 0, 1)), aim));
+	const float cone = 20.0f;
+	const int count = 9;
+
+	CHECK(NearlyEqual(ArcFanDirection(aim, up, cone, 0, count), aim));
+	CHECK(NearlyEqual(ArcFanDirection(aim, up, cone, 3, 1), aim));
+
+	for (int i = 1; i < count; i++)
+	{
+		Vec3 direction = ArcFanDirection(aim, up, cone, i, count);
+		float expected = (i % 2 == 0) ? cone : cone * 0.5f;
+
+		CHECK(NearlyEqual(SizeSquared(direction), 1.0f));
+		CHECK(NearlyEqual(AngleBetweenDeg(direction, aim), expected, 1.e-2f));
+		CHECK(NearlyEqual(ArcFanRing(i), expected / cone));
+	}
+
+	CHECK(ArcFanRing(0) == 0.0f);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+static void TestSelectBestArc()
+{
+	Vec3 locations[4] = { Vec3(100, 0, 0), Vec3(10, 0, 0), Vec3(1, 0, 0), Vec3(50, 0, 0) };
+
+	bool allValid[4] = { true, true, true, true };
+	CHECK(SelectBestArc(Vec3(0, 0, 0), allValid, locations, 4) == 2);
+
+	bool nearestInvalid[4] = { true, true, false, true };
+	CHECK(SelectBestArc(Vec3(0, 0, 0), nearestInvalid, locations, 4) == 1);
+
+	bool noneValid[4] = { false, false, false, false };
+	CHECK(SelectBestArc(Vec3(0, 0, 0), noneValid, locations, 4) == -1);
+	CHECK(SelectBestArc(Vec3(0, 0, 0), allValid, locations, 0) == -1);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+static void TestSelectBestArcByAngle()
+{
+	bool primaryValid[5] = { true, true, true, true, true };
+	CHECK(SelectBestArcByAngle(primaryValid, 5) == 0);
+
+	// Outer ring arcs are even indices, inner ring arcs odd
+	bool outerFirst[5] = { false, false, true, true, false };
+	CHECK(SelectBestArcByAngle(outerFirst, 5) == 3);
+
+	bool outerOnly[5] = { false, false, false, false, true };
+	CHECK(SelectBestArcByAngle(outerOnly, 5) == 4);
+
+	bool noneValid[5] = { false, false, false, false, false };
+	CHECK(SelectBestArcByAngle(noneValid, 5) == -1);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+static void TestArcCountForBudget()
+{
+	// Unknown cost or no budget keeps the requested fan
+	CHECK(ArcCountForBudget(17, 1.0f, 0.0f) == 17);
+	CHECK(ArcCountForBudget(17, 0.0f, 0.5f) == 17);
+
+	CHECK(ArcCountForBudget(17, 1.0f, 0.01f) == 17);
+	CHECK(ArcCountForBudget(17, 1.0f, 0.1f) == 10);
+	CHECK(ArcCountForBudget(17, 1.0f, 0.3f) == 3);
+
+	// The primary arc is always traced
+	CHECK(ArcCountForBudget(17, 1.0f, 5.0f) == 1);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+static void TestSampleBallisticArc()
+{
+	Vec3 points[64];
+
+	// No gravity is a straight line at launch velocity
+	int count = SampleBallisticArc(Vec3(0, 0, 0), Vec3(100, 0, 0), 0.0f, points, 64);
+	CHECK(count == 41);
+	CHECK(count == ArcMaxPoints);
+	CHECK(NearlyEqual(points[0], Vec3(0, 0, 0)));
+	CHECK(NearlyEqual(points[count - 1], Vec3(200, 0, 0), 1.e-2f));
+
+	// Under gravity z(t) = 0.5 * g * t^2 exactly, since the integration is trapezoidal
+	count = SampleBallisticArc(Vec3(0, 0, 0), Vec3(0, 0, 0), -980.0f, points, 64);
+	CHECK(NearlyEqual(points[20].Z, -0.5f * 980.0f * 1.0f, 1.e-1f));
+
+	// Output is clamped to the buffer
+	CHECK(SampleBallisticArc(Vec3(0, 0, 0), Vec3(1, 0, 0), -980.0f, points, 5) == 5);
+	CHECK(SampleBallisticArc(Vec3(0, 0, 0), Vec3(1, 0, 0), -980.0f, points, 0) == 0);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+static void TestInvalidArcEnd()
+{
+	CHECK(NearlyEqual(InvalidArcEnd(Vec3(1, 2, 3), Vec3(0, 1, 0)), Vec3(1, 2 + InvalidArcLength, 3)));
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+static void TestTeleportDestination()
+{
+	// Only the horizontal HMD offset is removed, height comes from the destination
+	CHECK(NearlyEqual(TeleportDestination(Vec3(100, 200, 50), Vec3(10, -20, 170)), Vec3(90, 220, 50)));
+	CHECK(NearlyEqual(TeleportDestination(Vec3(100, 200, 50), Vec3(0, 0, 0)), Vec3(100, 200, 50)));
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+static void TestNearestPoint()
+{
+	Vec3 points[3] = { Vec3(5, 0, 0), Vec3(1, 1, 0), Vec3(9, 9, 9) };
+
+	CHECK(NearestPoint(Vec3(0, 0, 0), points, 3) == 1);
+	CHECK(NearestPoint(Vec3(10, 10, 10), points, 3) == 2);
+	CHECK(NearestPoint(Vec3(0, 0, 0), points, 0) == -1);
+
+	// Ties keep the first point
+	Vec3 tied[2] = { Vec3(1, 0, 0), Vec3(-1, 0, 0) };
+	CHECK(NearestPoint(Vec3(0, 0, 0), tied, 2) == 0);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+static void TestMoveDirection()
+{
+	// Y is dropped before normalizing, same as the original MoveForward/MoveSide
+	CHECK(NearlyEqual(MoveDirection(Vec3(3, 5, 4)), Vec3(0.6f, 0, 0.8f)));
+	CHECK(NearlyEqual(MoveDirection(Vec3(0, 1, 0)), Vec3(0, 0, 0)));
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+int main()
+{
+	TestRotateAngleAxis();
+	TestSafeNormal();
+	TestArcFanDirection();
+	TestSelectBestArc();
+	TestSelectBestArcByAngle();
+	TestArcCountForBudget();
+	TestSampleBallisticArc();
+	TestInvalidArcEnd();
+	TestTeleportDestination();
+	TestNearestPoint();
+	TestMoveDirection();
+
+	if (Failures > 0)
+	{
+		std::printf("%d check(s) failed\n", Failures);
+		return 1;
+	}
+
+	std::printf("All VRTestCore tests passed\n");
+	return 0;
+}